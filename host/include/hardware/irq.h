@@ -0,0 +1,22 @@
+#ifndef _HARDWARE_IRQ_H_INCLUDE_
+#define _HARDWARE_IRQ_H_INCLUDE_
+
+// Host build shim: IRQ numbers match the RP2040, handlers are called by the simulator
+
+#include "pico/types.h"
+
+#define DMA_IRQ_0       11
+#define DMA_IRQ_1       12
+#define IO_IRQ_BANK0    13
+#define PIO0_IRQ_0      7
+#define PIO0_IRQ_1      8
+#define PIO1_IRQ_0      9
+#define PIO1_IRQ_1      10
+
+typedef void (*irq_handler_t)(void);
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler);
+void irq_set_enabled(uint num, bool enabled);
+bool irq_is_enabled(uint num);
+
+#endif
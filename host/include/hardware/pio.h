@@ -0,0 +1,107 @@
+#ifndef _HARDWARE_PIO_H_INCLUDE_
+#define _HARDWARE_PIO_H_INCLUDE_
+
+// Host build shim: PIO blocks are modelled at the FIFO level. The state machine program
+// itself is not interpreted, the simulator shifts whole bytes when the virtual Game Boy
+// clocks a transfer (see sim_link_transfer() in sim_hal.h).
+
+#include "pico/types.h"
+#include "hardware/gpio.h"
+
+#define NUM_PIO_STATE_MACHINES  4
+#define PIO_FIFO_DEPTH          4
+
+typedef struct pio_hw {
+    // only used for their addresses, DMA transfers to or from them hit the simulated FIFOs
+    volatile uint32_t txf[NUM_PIO_STATE_MACHINES];
+    volatile uint32_t rxf[NUM_PIO_STATE_MACHINES];
+} pio_hw_t;
+
+typedef pio_hw_t *PIO;
+
+extern pio_hw_t sim_pio_hw[2];
+
+#define pio0 (&sim_pio_hw[0])
+#define pio1 (&sim_pio_hw[1])
+
+typedef struct pio_program {
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin;
+} pio_program_t;
+
+typedef struct {
+    uint32_t clkdiv;
+    uint32_t execctrl;
+    uint32_t shiftctrl;
+    uint32_t pinctrl;
+} pio_sm_config;
+
+enum pio_interrupt_source {
+    pis_interrupt0 = 8,
+    pis_interrupt1 = 9,
+    pis_interrupt2 = 10,
+    pis_interrupt3 = 11,
+};
+
+uint pio_add_program(PIO pio, const pio_program_t *program);
+int pio_claim_unused_sm(PIO pio, bool required);
+void pio_sm_claim(PIO pio, uint sm);
+
+void pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config);
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled);
+void pio_enable_sm_mask_in_sync(PIO pio, uint32_t mask);
+void pio_sm_restart(PIO pio, uint sm);
+void pio_sm_clkdiv_restart(PIO pio, uint sm);
+void pio_sm_exec(PIO pio, uint sm, uint instr);
+void pio_sm_clear_fifos(PIO pio, uint sm);
+
+void pio_sm_put(PIO pio, uint sm, uint32_t data);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+uint32_t pio_sm_get(PIO pio, uint sm);
+uint32_t pio_sm_get_blocking(PIO pio, uint sm);
+uint pio_sm_get_rx_fifo_level(PIO pio, uint sm);
+uint pio_sm_get_tx_fifo_level(PIO pio, uint sm);
+
+static inline bool pio_sm_is_rx_fifo_empty(PIO pio, uint sm) {
+    return pio_sm_get_rx_fifo_level(pio, sm) == 0;
+}
+
+static inline bool pio_sm_is_rx_fifo_full(PIO pio, uint sm) {
+    return pio_sm_get_rx_fifo_level(pio, sm) == PIO_FIFO_DEPTH;
+}
+
+static inline bool pio_sm_is_tx_fifo_empty(PIO pio, uint sm) {
+    return pio_sm_get_tx_fifo_level(pio, sm) == 0;
+}
+
+static inline bool pio_sm_is_tx_fifo_full(PIO pio, uint sm) {
+    return pio_sm_get_tx_fifo_level(pio, sm) == PIO_FIFO_DEPTH;
+}
+
+void pio_set_irq0_source_enabled(PIO pio, enum pio_interrupt_source source, bool enabled);
+bool pio_interrupt_get(PIO pio, uint pio_interrupt_num);
+void pio_interrupt_clear(PIO pio, uint pio_interrupt_num);
+
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx);
+
+// Pin and config plumbing, accepted and ignored
+static inline pio_sm_config pio_get_default_sm_config(void) {
+    pio_sm_config c = {0};
+    return c;
+}
+
+static inline void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap) { (void)c; (void)wrap_target; (void)wrap; }
+static inline void sm_config_set_in_pins(pio_sm_config *c, uint in_base) { (void)c; (void)in_base; }
+static inline void sm_config_set_out_pins(pio_sm_config *c, uint out_base, uint out_count) { (void)c; (void)out_base; (void)out_count; }
+static inline void sm_config_set_in_shift(pio_sm_config *c, bool shift_right, bool autopush, uint push_threshold) { (void)c; (void)shift_right; (void)autopush; (void)push_threshold; }
+static inline void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold) { (void)c; (void)shift_right; (void)autopull; (void)pull_threshold; }
+static inline void sm_config_set_clkdiv(pio_sm_config *c, float div) { (void)c; (void)div; }
+static inline void pio_gpio_init(PIO pio, uint pin) { (void)pio; (void)pin; }
+static inline int pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out) { (void)pio; (void)sm; (void)pin_base; (void)pin_count; (void)is_out; return 0; }
+
+static inline uint pio_encode_jmp(uint addr) {
+    return addr;
+}
+
+#endif
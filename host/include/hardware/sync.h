@@ -0,0 +1,24 @@
+#ifndef _HARDWARE_SYNC_H_INCLUDE_
+#define _HARDWARE_SYNC_H_INCLUDE_
+
+// Host build shim: "interrupts" are the simulated IRQ handlers, masking them defers
+// delivery until restore_interrupts(), exactly like PRIMASK on the RP2040
+
+#include "pico/types.h"
+
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+
+static inline void __dmb(void) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __mem_fence_acquire(void) {
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+}
+
+static inline void __mem_fence_release(void) {
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef _HARDWARE_TIMER_H_INCLUDE_
+#define _HARDWARE_TIMER_H_INCLUDE_
+
+// Host build shim: the microsecond timer reads the simulated clock, see sim_hal.c
+
+#include "pico/types.h"
+
+uint64_t time_us_64(void);
+
+static inline uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+#endif
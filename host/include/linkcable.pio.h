@@ -0,0 +1,26 @@
+#ifndef _LINKCABLE_PIO_H_INCLUDE_
+#define _LINKCABLE_PIO_H_INCLUDE_
+
+// Host build stand-in for the pioasm output of src/linkcable.pio. The simulator implements
+// the program's behaviour itself, only the pin assignment and the init hook are kept.
+
+#include "hardware/pio.h"
+
+#define PIN_SCK     2
+#define PIN_SIN     0
+#define PIN_SOUT    3
+
+static const uint16_t linkcable_program_instructions[] = { 0 };
+
+static const struct pio_program linkcable_program = {
+    .instructions = linkcable_program_instructions,
+    .length = 1,
+    .origin = -1,
+};
+
+static inline void linkcable_program_init(PIO pio, uint sm, uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    pio_sm_init(pio, sm, offset, &c);
+}
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef LWIP_HDR_ERR_H
+#define LWIP_HDR_ERR_H
+
+// Host build shim: only what websocket_server.h needs, the simulator has no network stack
+
+#include <stdint.h>
+
+typedef int8_t err_t;
+
+#define ERR_OK      0
+#define ERR_MEM     -1
+#define ERR_BUF     -2
+#define ERR_ARG     -16
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef LWIP_HDR_PBUF_H
+#define LWIP_HDR_PBUF_H
+
+// Host build shim: opaque packet buffer
+
+#include "lwip/err.h"
+
+struct pbuf;
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef LWIP_HDR_TCP_H
+#define LWIP_HDR_TCP_H
+
+// Host build shim: opaque protocol control block
+
+#include "lwip/err.h"
+
+struct tcp_pcb;
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef _PICO_STDLIB_H_INCLUDE_
+#define _PICO_STDLIB_H_INCLUDE_
+
+// Host build shim for pico/stdlib.h
+
+#include <stdio.h>
+#include "pico/types.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+
+static inline void tight_loop_contents(void) {}
+
+static inline bool stdio_init_all(void) {
+    return true;
+}
+
+#endif
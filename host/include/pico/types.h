@@ -0,0 +1,14 @@
+#ifndef _PICO_TYPES_H_INCLUDE_
+#define _PICO_TYPES_H_INCLUDE_
+
+// Host build shim: the subset of pico/types.h the firmware modules rely on
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+
+typedef uint64_t absolute_time_t;
+
+#endif
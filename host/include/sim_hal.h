@@ -0,0 +1,35 @@
+#ifndef _SIM_HAL_H_INCLUDE_
+#define _SIM_HAL_H_INCLUDE_
+
+// Simulated RP2040 backend for the host build. The firmware modules call the usual
+// pico-sdk functions, the shims in host/include route them here.
+
+#include "pico/types.h"
+
+// Game Boy internal serial clock: 8192 Hz, 122 us per bit
+#define SIM_LINK_BIT_US         122
+#define SIM_LINK_BYTE_US        (8 * SIM_LINK_BIT_US)
+
+typedef struct {
+    uint64_t transfers;         // bytes clocked by the master
+    uint32_t tx_underruns;      // transfers that found the TX FIFO empty, the PIO shifted out X (0x06)
+    uint32_t rx_overflows;      // received bytes lost because the RX FIFO was full
+    uint32_t tx_overflows;      // writes into a full TX FIFO, dropped
+    uint32_t rx_underflows;     // reads from an empty RX FIFO
+    uint32_t irqs;              // interrupt handler invocations
+} sim_link_stats_t;
+
+// Clocks one byte as the Game Boy master: the state machine shifts out whatever it pulled
+// from its TX FIFO while master_byte is shifted in, then pushes it and raises PIO IRQ 0.
+// The simulated clock advances by SIM_LINK_BYTE_US. Returns the byte the master received.
+uint8_t sim_link_transfer(uint8_t master_byte);
+
+// Moves the simulated clock forward, firing alarms that fall due
+void sim_advance_us(uint64_t us);
+
+const sim_link_stats_t * sim_link_get_stats(void);
+
+// Messages the firmware handed to the (stubbed) WebSocket broadcast functions
+uint32_t sim_websocket_get_message_count(void);
+
+#endif
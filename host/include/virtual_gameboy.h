@@ -0,0 +1,41 @@
+#ifndef _VIRTUAL_GAMEBOY_H_INCLUDE_
+#define _VIRTUAL_GAMEBOY_H_INCLUDE_
+
+// Scripted Game Boy master for the host build: walks the Gen I cable club menu, runs the
+// preamble and the trade block exchange and confirms, the way a cartridge in the trade
+// center does, and checks every answer the device gives on the way.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "pokemon_data.h"
+
+// Clocks one byte, returns what the slave shifted out at the same time
+typedef uint8_t (*vgb_transfer_fn)(uint8_t master_byte, void *context);
+
+typedef struct {
+    uint8_t species;
+    uint8_t level;
+    const char *nickname;
+    const char *ot_name;
+    const char *trainer_name;
+    uint16_t trainer_id;
+    uint32_t seed;                  // random number stream of the master
+    bool party_terminator;          // fill the party species list with 0xFF like a cartridge does
+} vgb_trade_config_t;
+
+typedef struct {
+    bool ok;
+    char error[128];
+    size_t transfers;
+    trade_block_t partner_block;    // the block the device sent, as the master received it
+} vgb_trade_result_t;
+
+// Builds the trade block the master offers
+void vgb_build_trade_block(const vgb_trade_config_t *config, trade_block_t *block);
+
+// Runs one complete trade, returns result->ok
+bool vgb_run_trade(const vgb_trade_config_t *config, vgb_transfer_fn transfer, void *context, vgb_trade_result_t *result);
+
+#endif
@@ -0,0 +1,241 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "json_writer.h"
+
+// Host benchmark of json_writer.c against the snprintf and per-byte escape code the HTTP
+// renderers used before, on the two shapes the firmware writes most: /pokemon.json records
+// and trade log text. Both sides render the same output, which is compared before timing.
+//
+//   json_bench [-n iterations]
+
+#define BENCH_BUFFER    4096
+
+static volatile size_t bench_sink_bytes;
+
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// The former per-byte escape, only measures when dest is NULL
+static size_t bench_escape_bytes(char *dest, const char *src, size_t len) {
+    size_t written = 0;
+    for (size_t i = 0; i < len; i++) {
+        char escape = 0;
+        switch (src[i]) {
+            case '\n': escape = 'n'; break;
+            case '\r': escape = 'r'; break;
+            case '"':  escape = '"'; break;
+            case '\\': escape = '\\'; break;
+        }
+        if (escape) {
+            if (dest) {
+                dest[written] = '\\';
+                dest[written + 1] = escape;
+            }
+            written += 2;
+        } else {
+            if (dest) dest[written] = src[i];
+            written++;
+        }
+    }
+    return written;
+}
+
+typedef struct {
+    size_t slot;
+    const char *species;
+    const char *nickname;
+    unsigned level;
+    const char *type1;
+    const char *type2;
+    const char *trainer;
+    unsigned trainer_id;
+    unsigned long timestamp;
+    const char *game;
+} bench_slot_t;
+
+static const bench_slot_t bench_slot = {
+    17, "PIKACHU", "SPARKY", 25, "ELECTRIC", "ELECTRIC", "ASH", 12345, 987654321ul, "Red"
+};
+
+static size_t slot_snprintf(char *buffer, size_t size, const bench_slot_t *s) {
+    int written = snprintf(buffer, size,
+        "{\"slot\":%zu,\"species\":\"%s\",\"nickname\":\"%s\",\"level\":%u,"
+        "\"type1\":\"%s\",\"type2\":\"%s\",\"trainer\":\"%s\","
+        "\"trainer_id\":%u,\"timestamp\":%lu,\"game\":\"%s\"}",
+        s->slot, s->species, s->nickname, s->level, s->type1, s->type2, s->trainer,
+        s->trainer_id, s->timestamp, s->game);
+    return ((size_t)written < size) ? (size_t)written : (size - 1);
+}
+
+static void slot_json(json_writer_t *json, const bench_slot_t *s) {
+    json_object_begin(json);
+    json_key(json, "slot");
+    json_uint(json, s->slot);
+    json_key(json, "species");
+    json_string(json, s->species);
+    json_key(json, "nickname");
+    json_string(json, s->nickname);
+    json_key(json, "level");
+    json_uint(json, s->level);
+    json_key(json, "type1");
+    json_string(json, s->type1);
+    json_key(json, "type2");
+    json_string(json, s->type2);
+    json_key(json, "trainer");
+    json_string(json, s->trainer);
+    json_key(json, "trainer_id");
+    json_uint(json, s->trainer_id);
+    json_key(json, "timestamp");
+    json_uint(json, s->timestamp);
+    json_key(json, "game");
+    json_string(json, s->game);
+    json_object_end(json);
+}
+
+static size_t slot_writer(char *buffer, size_t size, const bench_slot_t *s) {
+    json_writer_t json;
+    json_init(&json, buffer, size);
+    slot_json(&json, s);
+    return json_length(&json);
+}
+
+static const char *bench_lines[] = {
+    "[12.345] TRADE: Entered trade center, waiting for the partner block\n",
+    "[12.401] STORAGE: Stored PIKACHU (Lv.25) in slot 17\n",
+    "[12.877] LINK: rx 0xFD tx 0xFD \"preamble\" after 3 retries\n",
+    "[13.002] ERROR: checksum C:\\save mismatch\r\n",
+};
+#define BENCH_LINES (sizeof(bench_lines) / sizeof(bench_lines[0]))
+
+// The former /logs.json body: measure every line, then escape it
+static size_t logs_bytes(char *buffer, size_t size) {
+    char *p = buffer;
+    p += snprintf(p, size, "{\"logs\":\"");
+    for (size_t i = 0; i < BENCH_LINES; i++) {
+        size_t len = strlen(bench_lines[i]);
+        if ((ptrdiff_t)bench_escape_bytes(NULL, bench_lines[i], len) > (buffer + size - 10 - p)) break;
+        p += bench_escape_bytes(p, bench_lines[i], len);
+    }
+    p += snprintf(p, size - (p - buffer), "\"}");
+    return p - buffer;
+}
+
+static size_t logs_writer(char *buffer, size_t size) {
+    json_writer_t json;
+    json_init(&json, buffer, size);
+    json_object_begin(&json);
+    json_key(&json, "logs");
+    json_string_begin(&json);
+    for (size_t i = 0; i < BENCH_LINES; i++) {
+        size_t len = strlen(bench_lines[i]);
+        if ((json_escaped_length(bench_lines[i], len) + 2) > json_space(&json)) break;
+        json_string_append(&json, bench_lines[i], len);
+    }
+    json_string_end(&json);
+    json_object_end(&json);
+    return json_length(&json);
+}
+
+static bool bench_sink(void *arg, const char *data, size_t len) {
+    (void)arg;
+    (void)data;
+    bench_sink_bytes += len;
+    return true;
+}
+
+// A whole 256 slot list through a 128 byte buffer, the way a stream hands it to TCP
+static size_t list_sink(char *buffer, size_t size) {
+    (void)size;
+    json_writer_t json;
+    json_init_sink(&json, buffer, 128, bench_sink, NULL);
+    json_object_begin(&json);
+    json_key(&json, "pokemon");
+    json_array_begin(&json);
+    for (size_t i = 0; i < 256; i++) slot_json(&json, &bench_slot);
+    json_array_end(&json);
+    json_object_end(&json);
+    return json_finish(&json);
+}
+
+static size_t list_snprintf(char *buffer, size_t size) {
+    char record[256];
+    size_t total = snprintf(record, sizeof(record), "{\"pokemon\":[");
+    for (size_t i = 0; i < 256; i++) {
+        char *p = buffer;
+        if (i) *p++ = ',';
+        p += slot_snprintf(p, size - 1, &bench_slot);
+        bench_sink_bytes += p - buffer;
+        total += p - buffer;
+    }
+    return total + 2;
+}
+
+static size_t bench_slot_snprintf(char *buffer, size_t size) {
+    return slot_snprintf(buffer, size, &bench_slot);
+}
+
+static size_t bench_slot_writer(char *buffer, size_t size) {
+    return slot_writer(buffer, size, &bench_slot);
+}
+
+typedef size_t (*bench_fn_t)(char *buffer, size_t size);
+
+static double bench_run(bench_fn_t fn, uint32_t iterations, size_t *bytes) {
+    static char buffer[BENCH_BUFFER];
+    uint64_t start = bench_now_ns();
+    for (uint32_t i = 0; i < iterations; i++) *bytes = fn(buffer, sizeof(buffer));
+    return (double)(bench_now_ns() - start) / iterations;
+}
+
+static void bench_pair(const char *name, bench_fn_t before, bench_fn_t after, uint32_t iterations) {
+    size_t before_bytes = 0;
+    size_t after_bytes = 0;
+    double before_ns = bench_run(before, iterations, &before_bytes);
+    double after_ns = bench_run(after, iterations, &after_bytes);
+    printf("%-12s %6zu bytes  snprintf %9.1f ns  json_writer %9.1f ns  %5.2fx\n",
+           name, after_bytes, before_ns, after_ns, before_ns / after_ns);
+}
+
+static bool bench_check(const char *name, bench_fn_t before, bench_fn_t after) {
+    char a[BENCH_BUFFER];
+    char b[BENCH_BUFFER];
+    size_t a_len = before(a, sizeof(a));
+    size_t b_len = after(b, sizeof(b));
+    if ((a_len != b_len) || memcmp(a, b, a_len)) {
+        printf("%s: outputs differ\n  %.*s\n  %.*s\n", name, (int)a_len, a, (int)b_len, b);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    uint32_t iterations = 200000;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && (i + 1 < argc)) {
+            iterations = strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [-n iterations]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (!iterations) iterations = 1;
+
+    if (!bench_check("slot", bench_slot_snprintf, bench_slot_writer) ||
+        !bench_check("logs", logs_bytes, logs_writer)) {
+        return 1;
+    }
+
+    bench_pair("slot", bench_slot_snprintf, bench_slot_writer, iterations);
+    bench_pair("logs", logs_bytes, logs_writer, iterations);
+    bench_pair("list (sink)", list_snprintf, list_sink, iterations / 256 + 1);
+    return 0;
+}
@@ -0,0 +1,190 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "pico/stdlib.h"
+
+#include "globals.h"
+#include "linkcable.h"
+#include "link_core.h"
+#include "link_latency.h"
+#include "pokemon_trading.h"
+#include "trade_log.h"
+#include "pokemon_data.h"
+#include "char_encode.h"
+#include "sim_hal.h"
+#include "virtual_gameboy.h"
+
+// Host-side driver: runs the trade firmware against the virtual Game Boy on the simulated
+// link cable, with the interrupt handler, watchdog and main loop pass from link_core.c
+// (single core, LINK_CORE_SPLIT is 0 here).
+//
+//   link_sim [-n trades] [-s every] [-g gap_us] [-r] [-v]
+//
+//   -n  number of back to back trades (soak test), default 1
+//   -s  the main loop gets to run only every n-th transfer, emulates USB/network stalls
+//   -g  idle time between two transfers in microseconds
+//   -r  send the party list with its 0xFF terminators like a real cartridge
+//   -v  latency histograms and trade log after the run
+
+bool debug_enable = false;
+
+static void main_loop_pass(void) {
+    link_core_process();
+}
+
+typedef struct {
+    uint32_t main_loop_every;
+    uint32_t gap_us;
+    uint64_t count;
+} link_sim_context_t;
+
+static uint8_t link_sim_transfer(uint8_t master_byte, void *context) {
+    link_sim_context_t *ctx = (link_sim_context_t *)context;
+    uint8_t answer = sim_link_transfer(master_byte);
+    if (ctx->gap_us) sim_advance_us(ctx->gap_us);
+    if ((++ctx->count % ctx->main_loop_every) == 0) main_loop_pass();
+    return answer;
+}
+
+static bool check_partner_block(const trade_block_t *block, char *error, size_t error_size) {
+    trade_session_t *session = pokemon_get_current_session();
+    char name[POKEMON_NAME_LENGTH + 1];
+
+    pokemon_encoded_array_to_str_until_terminator(name, (const uint8_t*)block->player_trainer_name, sizeof(name));
+    if (strcmp(name, session->local_trainer_name) != 0) {
+        snprintf(error, error_size, "partner block trainer name '%s', expected '%s'", name, session->local_trainer_name);
+        return false;
+    }
+    if (block->party_count != 1 || block->party_species[0] != block->pokemon_data[0].species) {
+        snprintf(error, error_size, "partner block party list mismatch");
+        return false;
+    }
+
+    pokemon_data_t pokemon;
+    memcpy(&pokemon.core, &block->pokemon_data[0], sizeof(pokemon_core_data_t));
+    pokemon.core.current_hp = bswap16(pokemon.core.current_hp);
+    pokemon.core.max_hp = bswap16(pokemon.core.max_hp);
+    pokemon_encoded_array_to_str_until_terminator(pokemon.nickname, (const uint8_t*)block->pokemon_nicknames[0], POKEMON_NAME_LENGTH);
+    pokemon_encoded_array_to_str_until_terminator(pokemon.ot_name, (const uint8_t*)block->original_trainer_names[0], POKEMON_OT_NAME_LENGTH);
+    if (!pokemon_validate_data(&pokemon)) {
+        snprintf(error, error_size, "partner block Pokemon does not validate");
+        return false;
+    }
+    return true;
+}
+
+static double wall_clock_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t trades = 1;
+    bool realistic_party = false;
+    bool verbose = false;
+    link_sim_context_t ctx = { .main_loop_every = 1, .gap_us = 0, .count = 0 };
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && (i + 1 < argc)) trades = strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-s") && (i + 1 < argc)) ctx.main_loop_every = strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-g") && (i + 1 < argc)) ctx.gap_us = strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-r")) realistic_party = true;
+        else if (!strcmp(argv[i], "-v")) verbose = true;
+        else {
+            fprintf(stderr, "usage: %s [-n trades] [-s every] [-g gap_us] [-r] [-v]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (!ctx.main_loop_every) ctx.main_loop_every = 1;
+
+    pokemon_trading_init();
+    link_core_launch();
+
+    vgb_trade_config_t config = {
+        .species = 0x01,
+        .level = 5,
+        .nickname = "BULBASAUR",
+        .ot_name = "RED",
+        .trainer_name = "RED",
+        .trainer_id = 0xBEEF,
+        .seed = 1,
+        .party_terminator = realistic_party,
+    };
+    vgb_trade_result_t result;
+    uint32_t failed = 0;
+    size_t stored_before = pokemon_get_stored_count();
+
+    double started = wall_clock_s();
+    uint64_t sim_started = time_us_64();
+    for (uint32_t n = 0; n < trades; n++) {
+        char error[128] = "";
+        config.seed = n + 1;
+        if (!vgb_run_trade(&config, link_sim_transfer, &ctx, &result)) {
+            snprintf(error, sizeof(error), "%s", result.error);
+        } else if (!check_partner_block(&result.partner_block, error, sizeof(error))) {
+            // error filled in
+        }
+        // the state machine leaves COMPLETE on its next pass, give it one like the idle main loop would
+        main_loop_pass();
+        if (pokemon_get_trade_state() != TRADE_STATE_IDLE) {
+            if (!error[0]) snprintf(error, sizeof(error), "state %d after the trade, expected IDLE", pokemon_get_trade_state());
+            pokemon_trading_reset();
+            linkcable_reset();
+        }
+        if (error[0]) {
+            printf("trade %u failed: %s\n", n, error);
+            failed++;
+        }
+    }
+    double elapsed = wall_clock_s() - started;
+    uint64_t sim_elapsed = time_us_64() - sim_started;
+
+    // the first trade lands in the first free slot, later ones replace slot 1 (see CONFIRMING)
+    if (stored_before == 0 && trades) {
+        pokemon_slot_t slot;
+        if (!pokemon_get_stored(0, &slot) || slot.pokemon.core.species != config.species || strcmp(slot.pokemon.nickname, config.nickname)) {
+            printf("stored Pokemon in slot 0 does not match the traded one\n");
+            if (!failed) failed = 1;
+        }
+    }
+
+    const sim_link_stats_t *stats = sim_link_get_stats();
+    printf("mode:              %s\n", LINKCABLE_USE_DMA ? "DMA ring" : "PIO IRQ");
+    printf("trades:            %u ok, %u failed\n", trades - failed, failed);
+    printf("transfers:         %llu\n", (unsigned long long)stats->transfers);
+    printf("link time:         %.3f s simulated\n", sim_elapsed / 1e6);
+    printf("host time:         %.3f s, %.0f transfers/s, %.3f us/transfer\n", elapsed,
+           stats->transfers / (elapsed > 0 ? elapsed : 1e-9), (elapsed * 1e6) / (stats->transfers ? stats->transfers : 1));
+    printf("interrupts:        %u\n", stats->irqs);
+    printf("tx underruns:      %u\n", stats->tx_underruns);
+    printf("rx overflows:      %u\n", stats->rx_overflows);
+    printf("tx overflows:      %u\n", stats->tx_overflows);
+    printf("ring overruns:     %u\n", linkcable_get_rx_overruns());
+    uint32_t late = 0, backlog = 0;
+    for (int state = 0; state < LINK_LATENCY_STATES; state++) {
+        late += link_latency_get((trade_state_t)state)->late;
+        backlog += link_latency_get((trade_state_t)state)->backlog;
+    }
+    printf("late answers:      %u\n", late);
+    printf("queued answers:    %u\n", backlog);
+    printf("ws messages:       %u\n", sim_websocket_get_message_count());
+
+    if (verbose) {
+        static char latency_json[2048];
+        link_latency_render_json(latency_json, sizeof(latency_json));
+        printf("\n%s\n\n", latency_json);
+        trade_event_t event;
+        char line[160];
+        for (uint32_t seq = trade_log_first(); seq != trade_log_end(); seq++) {
+            if (trade_log_read(seq, &event) && trade_log_render(&event, line, sizeof(line))) fputs(line, stdout);
+        }
+    }
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,541 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "pico/time.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+
+#include "linkcable.h"
+#include "sim_hal.h"
+
+// Link cable wiring, same as src/linkcable.pio
+#define SIM_PIN_SCK         2
+#define SIM_PIN_SIN         0
+#define SIM_PIN_SOUT        3
+
+// Value of X when the state machine pulls from an empty TX FIFO (set x, 6)
+#define SIM_PIO_PULL_EMPTY  6
+
+#define SIM_MAX_ALARMS      16
+#define SIM_NUM_IRQS        32
+
+static sim_link_stats_t link_stats;
+
+// Simulated clock ----------------------------------------------------------------------
+
+typedef struct {
+    bool active;
+    uint64_t target;
+    alarm_callback_t callback;
+    void *user_data;
+} sim_alarm_t;
+
+static uint64_t sim_now_us = 0;
+static sim_alarm_t sim_alarms[SIM_MAX_ALARMS];
+
+uint64_t time_us_64(void) {
+    return sim_now_us;
+}
+
+void sim_advance_us(uint64_t us) {
+    uint64_t end = sim_now_us + us;
+    while (true) {
+        // fire due alarms in order, a callback may schedule another one inside the window
+        sim_alarm_t *next = NULL;
+        for (int i = 0; i < SIM_MAX_ALARMS; i++) {
+            if (sim_alarms[i].active && sim_alarms[i].target <= end && (!next || sim_alarms[i].target < next->target)) {
+                next = &sim_alarms[i];
+            }
+        }
+        if (!next) break;
+        if (next->target > sim_now_us) sim_now_us = next->target;
+        next->active = false;
+        int64_t reschedule = next->callback((alarm_id_t)(next - sim_alarms) + 1, next->user_data);
+        if (reschedule > 0) {
+            next->target = sim_now_us + reschedule;
+            next->active = true;
+        } else if (reschedule < 0) {
+            next->target -= reschedule;
+            next->active = true;
+        }
+    }
+    sim_now_us = end;
+}
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    (void)fire_if_past;
+    for (int i = 0; i < SIM_MAX_ALARMS; i++) {
+        if (!sim_alarms[i].active) {
+            sim_alarms[i].active = true;
+            sim_alarms[i].target = sim_now_us + us;
+            sim_alarms[i].callback = callback;
+            sim_alarms[i].user_data = user_data;
+            return i + 1;
+        }
+    }
+    return -1;
+}
+
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    return add_alarm_in_us((uint64_t)ms * 1000, callback, user_data, fire_if_past);
+}
+
+bool cancel_alarm(alarm_id_t alarm_id) {
+    if (alarm_id < 1 || alarm_id > SIM_MAX_ALARMS || !sim_alarms[alarm_id - 1].active) return false;
+    sim_alarms[alarm_id - 1].active = false;
+    return true;
+}
+
+void sleep_us(uint64_t us) {
+    sim_advance_us(us);
+}
+
+void sleep_ms(uint32_t ms) {
+    sim_advance_us((uint64_t)ms * 1000);
+}
+
+// Interrupts ---------------------------------------------------------------------------
+
+static irq_handler_t sim_irq_handlers[SIM_NUM_IRQS];
+static bool sim_irq_enabled[SIM_NUM_IRQS];
+static bool sim_irq_pending[SIM_NUM_IRQS];
+static bool sim_irq_masked = false;
+static bool sim_irq_active = false;
+
+// Runs pending handlers unless interrupts are masked or a handler is already running
+static void sim_irq_dispatch(void) {
+    if (sim_irq_masked || sim_irq_active) return;
+    bool ran;
+    do {
+        ran = false;
+        for (uint num = 0; num < SIM_NUM_IRQS; num++) {
+            if (!sim_irq_pending[num] || !sim_irq_enabled[num] || !sim_irq_handlers[num]) continue;
+            sim_irq_pending[num] = false;
+            sim_irq_active = true;
+            link_stats.irqs++;
+            sim_irq_handlers[num]();
+            sim_irq_active = false;
+            ran = true;
+        }
+    } while (ran);
+}
+
+static void sim_irq_raise(uint num) {
+    sim_irq_pending[num] = true;
+    sim_irq_dispatch();
+}
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    sim_irq_handlers[num] = handler;
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    sim_irq_enabled[num] = enabled;
+    if (enabled) sim_irq_dispatch();
+}
+
+bool irq_is_enabled(uint num) {
+    return sim_irq_enabled[num];
+}
+
+uint32_t save_and_disable_interrupts(void) {
+    uint32_t status = sim_irq_masked;
+    sim_irq_masked = true;
+    return status;
+}
+
+void restore_interrupts(uint32_t status) {
+    sim_irq_masked = status;
+    sim_irq_dispatch();
+}
+
+// GPIO ---------------------------------------------------------------------------------
+
+static bool sim_gpio_level[NUM_BANK0_GPIOS] = {
+    [SIM_PIN_SCK] = true,           // the clock idles high
+    [SIM_PIN_SIN] = true,
+    [SIM_PIN_SOUT] = true,
+};
+
+void gpio_init(uint gpio) { (void)gpio; }
+void gpio_set_dir(uint gpio, bool out) { (void)gpio; (void)out; }
+void gpio_pull_up(uint gpio) { (void)gpio; }
+void gpio_pull_down(uint gpio) { (void)gpio; }
+
+void gpio_put(uint gpio, bool value) {
+    if (gpio < NUM_BANK0_GPIOS) sim_gpio_level[gpio] = value;
+}
+
+bool gpio_get(uint gpio) {
+    return (gpio < NUM_BANK0_GPIOS) ? sim_gpio_level[gpio] : false;
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback) {
+    // no simulated buttons
+    (void)gpio; (void)event_mask; (void)enabled; (void)callback;
+}
+
+// PIO ----------------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t data[PIO_FIFO_DEPTH];
+    uint head;
+    uint level;
+} sim_fifo_t;
+
+typedef struct {
+    bool claimed;
+    bool enabled;
+    sim_fifo_t tx;
+    sim_fifo_t rx;
+} sim_sm_t;
+
+typedef struct {
+    sim_sm_t sm[NUM_PIO_STATE_MACHINES];
+    uint32_t irq_flags;
+    uint32_t irq0_sources;
+    uint program_offset;
+} sim_pio_t;
+
+pio_hw_t sim_pio_hw[2];
+static sim_pio_t sim_pio[2];
+
+static void sim_dma_service(void);
+
+static inline uint sim_pio_index(PIO pio) {
+    return (uint)(pio - sim_pio_hw);
+}
+
+static inline sim_sm_t * sim_sm(PIO pio, uint sm) {
+    return &sim_pio[sim_pio_index(pio)].sm[sm];
+}
+
+static bool sim_fifo_push(sim_fifo_t *fifo, uint32_t value) {
+    if (fifo->level == PIO_FIFO_DEPTH) return false;
+    fifo->data[(fifo->head + fifo->level++) % PIO_FIFO_DEPTH] = value;
+    return true;
+}
+
+static bool sim_fifo_pop(sim_fifo_t *fifo, uint32_t *value) {
+    if (!fifo->level) return false;
+    *value = fifo->data[fifo->head];
+    fifo->head = (fifo->head + 1) % PIO_FIFO_DEPTH;
+    fifo->level--;
+    return true;
+}
+
+static void sim_pio_set_irq(PIO pio, uint irq) {
+    uint index = sim_pio_index(pio);
+    sim_pio[index].irq_flags |= (1u << irq);
+    if (sim_pio[index].irq0_sources & (1u << (pis_interrupt0 + irq))) {
+        sim_irq_raise(index ? PIO1_IRQ_0 : PIO0_IRQ_0);
+    }
+}
+
+uint pio_add_program(PIO pio, const pio_program_t *program) {
+    sim_pio_t *p = &sim_pio[sim_pio_index(pio)];
+    uint offset = p->program_offset;
+    p->program_offset += program->length;
+    return offset;
+}
+
+int pio_claim_unused_sm(PIO pio, bool required) {
+    (void)required;
+    for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; sm++) {
+        if (!sim_sm(pio, sm)->claimed) {
+            sim_sm(pio, sm)->claimed = true;
+            return sm;
+        }
+    }
+    return -1;
+}
+
+void pio_sm_claim(PIO pio, uint sm) {
+    sim_sm(pio, sm)->claimed = true;
+}
+
+void pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config) {
+    (void)initial_pc; (void)config;
+    sim_sm_t *s = sim_sm(pio, sm);
+    s->enabled = false;
+    memset(&s->tx, 0, sizeof(s->tx));
+    memset(&s->rx, 0, sizeof(s->rx));
+}
+
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) {
+    sim_sm(pio, sm)->enabled = enabled;
+}
+
+void pio_enable_sm_mask_in_sync(PIO pio, uint32_t mask) {
+    for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; sm++) {
+        if (mask & (1u << sm)) sim_sm(pio, sm)->enabled = true;
+    }
+}
+
+void pio_sm_restart(PIO pio, uint sm) { (void)pio; (void)sm; }
+void pio_sm_clkdiv_restart(PIO pio, uint sm) { (void)pio; (void)sm; }
+void pio_sm_exec(PIO pio, uint sm, uint instr) { (void)pio; (void)sm; (void)instr; }
+
+void pio_sm_clear_fifos(PIO pio, uint sm) {
+    sim_sm_t *s = sim_sm(pio, sm);
+    s->tx.level = 0;
+    s->rx.level = 0;
+    sim_dma_service();
+}
+
+void pio_sm_put(PIO pio, uint sm, uint32_t data) {
+    if (!sim_fifo_push(&sim_sm(pio, sm)->tx, data)) link_stats.tx_overflows++;
+}
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+    // nothing drains the FIFO while the caller waits, so a full FIFO drops like pio_sm_put()
+    pio_sm_put(pio, sm, data);
+}
+
+uint32_t pio_sm_get(PIO pio, uint sm) {
+    uint32_t value = 0;
+    if (!sim_fifo_pop(&sim_sm(pio, sm)->rx, &value)) link_stats.rx_underflows++;
+    return value;
+}
+
+uint32_t pio_sm_get_blocking(PIO pio, uint sm) {
+    return pio_sm_get(pio, sm);
+}
+
+uint pio_sm_get_rx_fifo_level(PIO pio, uint sm) {
+    return sim_sm(pio, sm)->rx.level;
+}
+
+uint pio_sm_get_tx_fifo_level(PIO pio, uint sm) {
+    return sim_sm(pio, sm)->tx.level;
+}
+
+void pio_set_irq0_source_enabled(PIO pio, enum pio_interrupt_source source, bool enabled) {
+    sim_pio_t *p = &sim_pio[sim_pio_index(pio)];
+    if (enabled) p->irq0_sources |= (1u << source);
+    else p->irq0_sources &= ~(1u << source);
+}
+
+bool pio_interrupt_get(PIO pio, uint pio_interrupt_num) {
+    return (sim_pio[sim_pio_index(pio)].irq_flags & (1u << pio_interrupt_num)) != 0;
+}
+
+void pio_interrupt_clear(PIO pio, uint pio_interrupt_num) {
+    sim_pio[sim_pio_index(pio)].irq_flags &= ~(1u << pio_interrupt_num);
+}
+
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx) {
+    uint base = sim_pio_index(pio) ? (is_tx ? DREQ_PIO1_TX0 : DREQ_PIO1_RX0) : (is_tx ? DREQ_PIO0_TX0 : DREQ_PIO0_RX0);
+    return base + sm;
+}
+
+// DMA ----------------------------------------------------------------------------------
+
+typedef struct {
+    bool claimed;
+    bool busy;
+    dma_channel_config config;
+    dma_channel_hw_t hw;
+} sim_dma_channel_t;
+
+static sim_dma_channel_t sim_dma[NUM_DMA_CHANNELS];
+static uint32_t sim_dma_irq0_enabled = 0;
+static uint32_t sim_dma_ints0 = 0;
+static bool sim_dma_servicing = false;
+static bool sim_dma_again = false;
+
+static bool sim_dreq_ready(uint dreq) {
+    if (dreq == DREQ_FORCE) return true;
+    PIO pio = (dreq >= DREQ_PIO1_TX0) ? pio1 : pio0;
+    uint sm = dreq % NUM_PIO_STATE_MACHINES;
+    bool is_rx = (dreq % DREQ_PIO1_TX0) >= DREQ_PIO0_RX0;
+    return is_rx ? (sim_sm(pio, sm)->rx.level > 0) : (sim_sm(pio, sm)->tx.level < PIO_FIFO_DEPTH);
+}
+
+// FIFO registers are recognised by address, everything else is host memory
+static sim_fifo_t * sim_fifo_at(uintptr_t addr, bool *is_tx) {
+    for (uint p = 0; p < 2; p++) {
+        for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; sm++) {
+            if (addr == (uintptr_t)&sim_pio_hw[p].txf[sm]) { *is_tx = true; return &sim_pio[p].sm[sm].tx; }
+            if (addr == (uintptr_t)&sim_pio_hw[p].rxf[sm]) { *is_tx = false; return &sim_pio[p].sm[sm].rx; }
+        }
+    }
+    return NULL;
+}
+
+static uintptr_t sim_dma_next_addr(uintptr_t addr, uint width, uint ring_bits) {
+    uintptr_t next = addr + width;
+    if (ring_bits) {
+        uintptr_t mask = ((uintptr_t)1 << ring_bits) - 1;
+        next = (addr & ~mask) | (next & mask);
+    }
+    return next;
+}
+
+static void sim_dma_transfer_one(sim_dma_channel_t *c) {
+    uint width = 1u << c->config.size;
+    uint32_t value = 0;
+    bool is_tx;
+
+    sim_fifo_t *fifo = sim_fifo_at(c->hw.read_addr, &is_tx);
+    if (fifo) sim_fifo_pop(fifo, &value);
+    else memcpy(&value, (const void *)c->hw.read_addr, width);
+
+    fifo = sim_fifo_at(c->hw.write_addr, &is_tx);
+    if (fifo) {
+        // narrow writes are replicated across the byte lanes of the FIFO register
+        if (width == 1) value = (value & 0xFF) * 0x01010101u;
+        else if (width == 2) value = (value & 0xFFFF) * 0x00010001u;
+        sim_fifo_push(fifo, value);
+    } else {
+        memcpy((void *)c->hw.write_addr, &value, width);
+    }
+
+    if (c->config.read_increment) {
+        c->hw.read_addr = sim_dma_next_addr(c->hw.read_addr, width, c->config.ring_write ? 0 : c->config.ring_size_bits);
+    }
+    if (c->config.write_increment) {
+        c->hw.write_addr = sim_dma_next_addr(c->hw.write_addr, width, c->config.ring_write ? c->config.ring_size_bits : 0);
+    }
+}
+
+// Runs every channel as far as its DREQ allows. Called whenever a FIFO or a channel changes,
+// completion handlers may re-trigger channels from inside, those calls just request another pass.
+static void sim_dma_service(void) {
+    if (sim_dma_servicing) {
+        sim_dma_again = true;
+        return;
+    }
+    sim_dma_servicing = true;
+    do {
+        sim_dma_again = false;
+        for (uint ch = 0; ch < NUM_DMA_CHANNELS; ch++) {
+            sim_dma_channel_t *c = &sim_dma[ch];
+            while (c->busy && sim_dreq_ready(c->config.dreq)) {
+                sim_dma_transfer_one(c);
+                if (--c->hw.transfer_count == 0) {
+                    c->busy = false;
+                    sim_dma_ints0 |= (1u << ch);
+                    if (sim_dma_irq0_enabled & (1u << ch)) sim_irq_raise(DMA_IRQ_0);
+                }
+            }
+        }
+    } while (sim_dma_again);
+    sim_dma_servicing = false;
+}
+
+int dma_claim_unused_channel(bool required) {
+    (void)required;
+    for (uint ch = 0; ch < NUM_DMA_CHANNELS; ch++) {
+        if (!sim_dma[ch].claimed) {
+            sim_dma[ch].claimed = true;
+            return ch;
+        }
+    }
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel) {
+    sim_dma[channel].claimed = false;
+}
+
+void dma_channel_start(uint channel) {
+    sim_dma_channel_t *c = &sim_dma[channel];
+    c->busy = (c->hw.transfer_count != 0);
+    sim_dma_service();
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+    sim_dma_channel_t *c = &sim_dma[channel];
+    c->config = *config;
+    c->hw.write_addr = (uintptr_t)write_addr;
+    c->hw.read_addr = (uintptr_t)read_addr;
+    c->hw.transfer_count = transfer_count;
+    if (trigger) dma_channel_start(channel);
+}
+
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger) {
+    sim_dma[channel].hw.read_addr = (uintptr_t)read_addr;
+    if (trigger) dma_channel_start(channel);
+}
+
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger) {
+    sim_dma[channel].hw.write_addr = (uintptr_t)write_addr;
+    if (trigger) dma_channel_start(channel);
+}
+
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger) {
+    sim_dma[channel].hw.transfer_count = trans_count;
+    if (trigger) dma_channel_start(channel);
+}
+
+void dma_channel_abort(uint channel) {
+    sim_dma[channel].busy = false;
+}
+
+bool dma_channel_is_busy(uint channel) {
+    return sim_dma[channel].busy;
+}
+
+dma_channel_hw_t * dma_channel_hw_addr(uint channel) {
+    return &sim_dma[channel].hw;
+}
+
+void dma_channel_set_irq0_enabled(uint channel, bool enabled) {
+    if (enabled) sim_dma_irq0_enabled |= (1u << channel);
+    else sim_dma_irq0_enabled &= ~(1u << channel);
+}
+
+bool dma_channel_get_irq0_status(uint channel) {
+    return (sim_dma_ints0 & (1u << channel)) != 0;
+}
+
+void dma_channel_acknowledge_irq0(uint channel) {
+    sim_dma_ints0 &= ~(1u << channel);
+}
+
+// Link cable ---------------------------------------------------------------------------
+
+uint8_t sim_link_transfer(uint8_t master_byte) {
+    sim_sm_t *s = sim_sm(LINKCABLE_PIO, LINKCABLE_SM);
+    uint8_t slave_byte = 0xFF;      // SOUT floats high when the state machine is stopped
+    link_stats.transfers++;
+
+    if (s->enabled) {
+        // first falling edge: pull noblock, the output byte sits in the low 8 bits of the word
+        uint32_t word;
+        if (!sim_fifo_pop(&s->tx, &word)) {
+            word = SIM_PIO_PULL_EMPTY;
+            link_stats.tx_underruns++;
+        }
+        slave_byte = (uint8_t)word;
+        sim_dma_service();
+    }
+
+    for (int bit = 7; bit >= 0; bit--) {
+        sim_gpio_level[SIM_PIN_SCK] = false;
+        sim_gpio_level[SIM_PIN_SOUT] = (slave_byte >> bit) & 1;
+        sim_gpio_level[SIM_PIN_SIN] = (master_byte >> bit) & 1;
+        sim_advance_us(SIM_LINK_BIT_US / 2);
+        sim_gpio_level[SIM_PIN_SCK] = true;
+        sim_advance_us(SIM_LINK_BIT_US - (SIM_LINK_BIT_US / 2));
+    }
+
+    if (s->enabled) {
+        // push noblock drops the byte when the RX FIFO is full, then irq 0
+        if (!sim_fifo_push(&s->rx, master_byte)) link_stats.rx_overflows++;
+        sim_dma_service();
+        sim_pio_set_irq(LINKCABLE_PIO, 0);
+    }
+    return slave_byte;
+}
+
+const sim_link_stats_t * sim_link_get_stats(void) {
+    return &link_stats;
+}
@@ -0,0 +1,81 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "websocket_server.h"
+#include "sim_hal.h"
+
+// The host build has no network stack: broadcasts are counted and dropped
+
+static uint32_t sim_websocket_messages = 0;
+
+void websocket_server_init(void) {}
+void websocket_server_process(void) {}
+
+err_t websocket_accept_connection(struct tcp_pcb *pcb, struct pbuf *p) {
+    (void)pcb; (void)p;
+    return ERR_OK;
+}
+
+void websocket_broadcast_text(const char *message) {
+    (void)message;
+    sim_websocket_messages++;
+}
+
+void websocket_broadcast_binary(const uint8_t *data, size_t length) {
+    (void)data; (void)length;
+    sim_websocket_messages++;
+}
+
+void websocket_send_text(ws_connection_t *conn, const char *message) {
+    (void)conn; (void)message;
+}
+
+void websocket_send_binary(ws_connection_t *conn, const uint8_t *data, size_t length) {
+    (void)conn; (void)data; (void)length;
+}
+
+void websocket_close_connection(ws_connection_t *conn) {
+    (void)conn;
+}
+
+size_t websocket_get_connection_count(void) {
+    return 0;
+}
+
+const ws_tx_stats_t *websocket_get_tx_stats(void) {
+    static ws_tx_stats_t stats;
+    return &stats;
+}
+
+void websocket_broadcast_trade_event(const char *event_type, const char *message) {
+    (void)event_type; (void)message;
+    sim_websocket_messages++;
+}
+
+void websocket_broadcast_protocol_data(uint8_t rx_byte, uint8_t tx_byte, trade_state_t state) {
+    (void)rx_byte; (void)tx_byte; (void)state;
+    sim_websocket_messages++;
+}
+
+uint32_t websocket_get_dropped_protocol_events(void) {
+    return 0;
+}
+
+void websocket_broadcast_pokemon_data(const char *pokemon_json) {
+    (void)pokemon_json;
+    sim_websocket_messages++;
+}
+
+void websocket_broadcast_status_update(const char *status_json) {
+    (void)status_json;
+    sim_websocket_messages++;
+}
+
+void websocket_broadcast_link_stats(void) {
+    sim_websocket_messages++;
+}
+
+uint32_t sim_websocket_get_message_count(void) {
+    return sim_websocket_messages;
+}
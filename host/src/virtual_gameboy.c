@@ -0,0 +1,127 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "pokemon_data.h"
+#include "pokemon_trading.h"
+#include "char_encode.h"
+#include "virtual_gameboy.h"
+
+typedef struct {
+    vgb_transfer_fn transfer;
+    void *context;
+    size_t count;
+    uint32_t rng;
+} vgb_link_t;
+
+static uint8_t vgb_send(vgb_link_t *link, uint8_t data) {
+    link->count++;
+    return link->transfer(data, link->context);
+}
+
+// Random numbers stay below 0xFD, the values from there on are reserved by the protocol
+static uint8_t vgb_random(vgb_link_t *link) {
+    link->rng = (link->rng * 1103515245u) + 12345u;
+    return (uint8_t)(((link->rng >> 16) & 0x7FFF) % SERIAL_PREAMBLE_BYTE);
+}
+
+static bool vgb_fail(vgb_trade_result_t *result, vgb_link_t *link, const char *what, uint8_t expected, uint8_t received) {
+    snprintf(result->error, sizeof(result->error), "transfer %zu: %s, expected 0x%02X, received 0x%02X",
+             link->count, what, expected, received);
+    result->transfers = link->count;
+    result->ok = false;
+    return false;
+}
+
+void vgb_build_trade_block(const vgb_trade_config_t *config, trade_block_t *block) {
+    memset(block, 0, sizeof(trade_block_t));
+
+    pokemon_str_to_encoded_array((uint8_t*)block->player_trainer_name, config->trainer_name, POKEMON_NAME_LENGTH, true);
+
+    // A cartridge terminates the species list with 0xFF. Off by default: pokemon_trading_update()
+    // takes a received 0xFF for "no data", so those bytes would be dropped from the exchange.
+    block->party_count = 1;
+    memset(block->party_species, config->party_terminator ? 0xFF : 0x00, sizeof(block->party_species));
+    block->party_species[0] = config->species;
+
+    // Multi-byte fields go over the cable big endian
+    pokemon_core_data_t *core = &block->pokemon_data[0];
+    uint16_t hp = 10 + (2 * config->level);
+    core->species = config->species;
+    core->current_hp = bswap16(hp);
+    core->level = config->level;
+    core->type1 = POKEMON_TYPE_NORMAL;
+    core->type2 = POKEMON_TYPE_NORMAL;
+    core->catch_rate = 45;
+    core->moves[0] = 0x21;          // Tackle
+    core->moves[1] = 0x2D;          // Growl
+    core->original_trainer_id = bswap16(config->trainer_id);
+    core->experience[2] = 125;
+    core->iv_data[0] = 0xAA;
+    core->iv_data[1] = 0xAA;
+    core->move_pp[0] = 35;
+    core->move_pp[1] = 40;
+    core->level_copy = config->level;
+    core->max_hp = bswap16(hp);
+    core->attack = bswap16(5 + config->level);
+    core->defense = bswap16(5 + config->level);
+    core->speed = bswap16(5 + config->level);
+    core->special = bswap16(5 + config->level);
+
+    pokemon_str_to_encoded_array((uint8_t*)block->original_trainer_names[0], config->ot_name, POKEMON_NAME_LENGTH, true);
+    pokemon_str_to_encoded_array((uint8_t*)block->pokemon_nicknames[0], config->nickname, POKEMON_NAME_LENGTH, true);
+}
+
+bool vgb_run_trade(const vgb_trade_config_t *config, vgb_transfer_fn transfer, void *context, vgb_trade_result_t *result) {
+    vgb_link_t link = { transfer, context, 0, config->seed };
+    trade_block_t block;
+    uint8_t answer;
+
+    memset(result, 0, sizeof(vgb_trade_result_t));
+    vgb_build_trade_block(config, &block);
+
+    // Every answer belongs to the byte clocked one transfer earlier
+
+    // Cable club: master/slave negotiation, then Trade Center highlighted and selected
+    vgb_send(&link, PKMN_MASTER);
+    answer = vgb_send(&link, PKMN_CONNECTED);
+    if (answer != PKMN_SLAVE) return vgb_fail(result, &link, "slave answer to master", PKMN_SLAVE, answer);
+    answer = vgb_send(&link, PKMN_MENU_TRADE_CENTRE_HIGHLIGHTED);
+    if (answer != PKMN_CONNECTED) return vgb_fail(result, &link, "connected echo", PKMN_CONNECTED, answer);
+    answer = vgb_send(&link, PKMN_MENU_TRADE_CENTRE_SELECTED);
+    if (answer != PKMN_MENU_TRADE_CENTRE_HIGHLIGHTED) return vgb_fail(result, &link, "menu highlight echo", PKMN_MENU_TRADE_CENTRE_HIGHLIGHTED, answer);
+
+    // Preamble and random numbers, the master ignores what the slave sends back here
+    answer = vgb_send(&link, SERIAL_PREAMBLE_BYTE);
+    if (answer != PKMN_BLANK) return vgb_fail(result, &link, "trade centre selection answer", PKMN_BLANK, answer);
+    for (int i = 1; i < SERIAL_RNS_LENGTH; i++) {
+        answer = vgb_send(&link, SERIAL_PREAMBLE_BYTE);
+        if (answer != SERIAL_PREAMBLE_BYTE) return vgb_fail(result, &link, "preamble echo", SERIAL_PREAMBLE_BYTE, answer);
+    }
+    for (int i = 0; i < SERIAL_RNS_LENGTH; i++) vgb_send(&link, vgb_random(&link));
+    for (int i = 0; i < SERIAL_TRADE_BLOCK_PREAMBLE_LENGTH; i++) vgb_send(&link, SERIAL_PREAMBLE_BYTE);
+
+    // Block exchange: the partner's block arrives one transfer late, behind its preamble.
+    // The first confirmation byte clocks in its last byte.
+    uint8_t stream[sizeof(trade_block_t) + 1];
+    for (size_t i = 0; i < sizeof(trade_block_t); i++) {
+        stream[i] = vgb_send(&link, ((const uint8_t*)&block)[i]);
+    }
+    stream[sizeof(trade_block_t)] = vgb_send(&link, PKMN_BLANK);
+
+    size_t start = 0;
+    while ((start < sizeof(stream)) && (stream[start] == SERIAL_PREAMBLE_BYTE)) start++;
+    if (start != 1) return vgb_fail(result, &link, "block start after preamble", 1, (uint8_t)start);
+    memcpy(&result->partner_block, &stream[start], sizeof(trade_block_t));
+
+    // Confirmation
+    vgb_send(&link, TRADE_CONFIRM_BYTE);
+    answer = vgb_send(&link, PKMN_BLANK);
+    if (answer != TRADE_RESPONSE_SUCCESS) return vgb_fail(result, &link, "trade confirmation", TRADE_RESPONSE_SUCCESS, answer);
+
+    result->transfers = link.count;
+    result->ok = true;
+    return true;
+}
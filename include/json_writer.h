@@ -0,0 +1,78 @@
+#ifndef _JSON_WRITER_H_INCLUDE_
+#define _JSON_WRITER_H_INCLUDE_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// JSON writer for the HTTP and WebSocket answers. Commas are placed by the writer, strings are
+// escaped while they are copied, scanning a word at a time for the bytes that need it. Output
+// goes into a caller's buffer and never runs past it: what does not fit is dropped and counted,
+// so a writer on an empty buffer measures. With a sink the buffer is handed over whenever it
+// fills up instead, to stream output of any length through a small buffer.
+//
+// A writer without a sink can be copied to mark a position and copied back to return to it.
+#define JSON_MAX_DEPTH      32
+
+// Takes len bytes of output, false stops the writer as if the buffer was full
+typedef bool (*json_sink_t)(void * arg, const char * data, size_t len);
+
+typedef struct {
+    char * buffer;
+    size_t size;
+    size_t len;                     // bytes in the buffer
+    size_t total;                   // bytes produced, including those dropped
+    json_sink_t sink;
+    void * sink_arg;
+    uint32_t items;                 // bit per depth: a value was written at that depth
+    uint8_t depth;
+    bool key;                       // a key was written, its value takes no comma
+    bool overflow;                  // output was dropped
+} json_writer_t;
+
+void json_init(json_writer_t * json, char * buffer, size_t size);
+void json_init_sink(json_writer_t * json, char * buffer, size_t size, json_sink_t sink, void * arg);
+
+void json_object_begin(json_writer_t * json);
+void json_object_end(json_writer_t * json);
+void json_array_begin(json_writer_t * json);
+void json_array_end(json_writer_t * json);
+
+// Object keys are written as they are, they are names from the firmware
+void json_key(json_writer_t * json, const char * key);
+
+void json_string(json_writer_t * json, const char * value);
+void json_string_len(json_writer_t * json, const char * value, size_t len);
+void json_int(json_writer_t * json, int32_t value);
+void json_uint(json_writer_t * json, uint32_t value);
+void json_bool(json_writer_t * json, bool value);
+
+// A string value written in pieces
+void json_string_begin(json_writer_t * json);
+void json_string_append(json_writer_t * json, const char * value, size_t len);
+void json_string_end(json_writer_t * json);
+
+// Bytes copied as they are, outside of the comma bookkeeping
+void json_raw(json_writer_t * json, const char * data, size_t len);
+// A value rendered elsewhere, copied as it is and placed like any other value
+void json_raw_value(json_writer_t * json, const char * data, size_t len);
+
+// Hands the rest to the sink, returns the bytes produced
+size_t json_finish(json_writer_t * json);
+
+// Length of a string once escaped, without the quotes
+size_t json_escaped_length(const char * value, size_t len);
+
+static inline size_t json_length(const json_writer_t * json) {
+    return json->len;
+}
+
+static inline size_t json_space(const json_writer_t * json) {
+    return json->size - json->len;
+}
+
+static inline bool json_overflowed(const json_writer_t * json) {
+    return json->overflow;
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef _LINK_CORE_H_INCLUDE_
+#define _LINK_CORE_H_INCLUDE_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "pokemon_data.h"
+
+// Core split: the link cable interrupts, the PIO/DMA servicing and the trade state machine
+// run on core 1, USB, lwIP and the storage stay on core 0. The cores only talk through
+// SPSC queues: storage commits from core 1 to core 0 and resets and trade requests from
+// core 0 to core 1 in link_core.c, protocol events in websocket_server.c.
+// Set to 0 to run everything on core 0.
+#ifndef LINK_CORE_SPLIT
+#define LINK_CORE_SPLIT         0
+#endif
+
+#define LINK_CORE_WATCHDOG_US   (300 * 1000)    // link reset when nothing was received for this long
+
+// Core 0 side
+void link_core_launch(void);                    // sets up the link cable, on core 1 when split
+void link_core_process(void);                   // call from the main loop
+void link_core_request_reset(void);             // link and trade state reset, safe from interrupts
+bool link_core_request_send(size_t index);
+
+// Trade state machine side
+bool link_core_commit_trade(const pokemon_data_t * pokemon, const char * source_game);
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef _LINK_LATENCY_H_INCLUDE_
+#define _LINK_LATENCY_H_INCLUDE_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "pokemon_data.h"
+#include "json_writer.h"
+
+// Link response latency: the time from a byte being shifted in to its answer being loaded
+// for the next transfer, collected per trade state. Buckets are powers of two in microseconds:
+// bucket 0 holds answers under 1 us, bucket n those in [2^(n-1), 2^n) us, the last one the rest.
+// Bytes are stamped in the link interrupt in both modes, in DMA mode the per-byte one. Answers
+// the lookahead exchange queued before their byte arrived have no latency, they are counted
+// as preloaded instead of sampled.
+#define LINK_LATENCY_BUCKETS    14
+#define LINK_LATENCY_STATES     (TRADE_STATE_ERROR + 1)
+
+typedef struct {
+    uint32_t samples;
+    uint32_t worst_us;
+    uint32_t late;                  // answer loaded after the next byte was already shifted in
+    uint32_t backlog;               // answer queued behind an older one the Game Boy has not clocked out yet
+    uint32_t preloaded;             // answer queued ahead, before its byte arrived
+    uint32_t buckets[LINK_LATENCY_BUCKETS];
+} link_latency_hist_t;
+
+// Byte received, called from the link interrupt
+void link_latency_rx(void);
+// Answer about to be loaded, state is the trade state the received byte was handled in
+void link_latency_tx(trade_state_t state);
+// The received byte's answer was queued ahead
+void link_latency_preloaded(trade_state_t state);
+
+void link_latency_reset(void);
+const link_latency_hist_t * link_latency_get(trade_state_t state);
+
+// Writes all states that have samples as a JSON object
+void link_latency_write_json(json_writer_t * json);
+// Same into a buffer, returns the length written, an empty object when it does not fit
+size_t link_latency_render_json(char * buffer, size_t size);
+
+#endif
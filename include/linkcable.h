@@ -10,21 +10,59 @@
 
 #define LINKCABLE_BITS      8
 
+// DMA ring buffer mode: RX bytes are written into a RAM ring and TX bytes are
+// pulled from a prepared ring by two DMA channels. The CPU is interrupted once per
+// LINKCABLE_DMA_BATCH received bytes, and per byte only while no answers are queued
+// ahead in the TX ring. Set to 0 for the per-byte IRQ mode.
+#ifndef LINKCABLE_USE_DMA
+    #define LINKCABLE_USE_DMA   0
+#endif
+
+#define LINKCABLE_DMA_RING_BITS 9                                  // ring size as a power of two
+#define LINKCABLE_DMA_RING_SIZE (1u << LINKCABLE_DMA_RING_BITS)    // 512 bytes each for RX and TX
+#define LINKCABLE_DMA_BATCH     16                                 // RX bytes per batch interrupt
+
+#if LINKCABLE_USE_DMA
+
+bool linkcable_rx_pop(uint8_t * data);
+size_t linkcable_rx_available(void);
+size_t linkcable_tx_write(const uint8_t * data, size_t length);
+size_t linkcable_tx_free(void);
+void linkcable_tx_flush(void);
+
+// Returns 0xFF when nothing was received, same as reading an idle line
 static inline uint8_t linkcable_receive(void) {
-    return pio_sm_get(LINKCABLE_PIO, LINKCABLE_SM);
+    uint8_t data;
+    return (linkcable_rx_pop(&data)) ? data : 0xFF;
+}
+
+static inline void linkcable_send(uint8_t data) {
+    linkcable_tx_write(&data, 1);
+}
+
+#else
+
+// Returns 0xFF when nothing was received, the main loop polls this between interrupts
+static inline uint8_t linkcable_receive(void) {
+    return (pio_sm_is_rx_fifo_empty(LINKCABLE_PIO, LINKCABLE_SM)) ? 0xFF : pio_sm_get(LINKCABLE_PIO, LINKCABLE_SM);
 }
 
 static inline void linkcable_send(uint8_t data) {
     pio_sm_put(LINKCABLE_PIO, LINKCABLE_SM, data);
 }
 
+#endif
+
 void linkcable_reset(void);
 void linkcable_init(irq_handler_t onReceive);
 
+// Link statistics, only meaningful in DMA mode
+uint32_t linkcable_get_rx_overruns(void);
+
 // Function to send a block of data
 void linkcable_send_data(const uint8_t* data, size_t length);
 
 // Function to prepare and send a Pokemon trade block with necessary byte swapping
 void linkcable_send_trade_block(const trade_block_t* trade_block);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,35 @@
+#ifndef _LOGIC_CAPTURE_H_INCLUDE_
+#define _LOGIC_CAPTURE_H_INCLUDE_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Background capture of SCK/SIN/SOUT for /gpio_monitor.json: a spare PIO state machine samples
+// the lines at a set rate from the first SCK falling edge on, a DMA channel moves the samples
+// into RAM. Nothing runs on the CPU until the trace is rendered, run-length encoded.
+#define LOGIC_CAPTURE_PIO       pio1
+#define LOGIC_CAPTURE_WORDS     2048                // 8 samples each, 16384 samples in 8 KB
+#define LOGIC_CAPTURE_SAMPLES   (LOGIC_CAPTURE_WORDS * 8)
+#define LOGIC_CAPTURE_RATE      1000000             // samples per second unless asked otherwise
+
+// Bits of a sample state in the rendered trace
+#define LOGIC_CAPTURE_SCK       0x01
+#define LOGIC_CAPTURE_SIN       0x02
+#define LOGIC_CAPTURE_SOUT      0x04
+
+// Arms a new capture, rate is clamped to what the PIO clock divider allows.
+// False when no state machine, program space or DMA channel is free.
+bool logic_capture_start(uint32_t rate);
+// Freezes the trace, the samples taken so far stay until the next start
+void logic_capture_stop(void);
+// Armed or sampling, false once the buffer is full or after a stop
+bool logic_capture_running(void);
+
+// Renders the trace as a JSON object, returns the length written. Stops a running capture.
+//   {"rate":R,"triggered":b,"samples":N,"levels":S,"runs":[S,n,S,n,...],"truncated":b}
+// S are LOGIC_CAPTURE_* bit masks, levels the lines right now, runs the state and length of
+// each stretch of equal samples.
+size_t logic_capture_render_json(char * buffer, size_t size);
+
+#endif
@@ -48,8 +48,44 @@
 #define LWIP_IP_ACCEPT_UDP_PORT(p)      ((p) == PP_NTOHS(67))
 
 #define TCP_MSS                         (1500 /*mtu*/ - 20 /*iphdr*/ - 20 /*tcphhr*/)
-#define TCP_SND_BUF                     (2 * TCP_MSS)
-#define TCP_WND                         (TCP_MSS)
+
+// Network throughput profile: the TCP windows, the send queue and the receive frame pool are
+// sized together. Pick one with cmake -DNET_PROFILE=..., /bench.json shows the one built in.
+// RAM is about 1.5 KB per pool pbuf plus MEM_SIZE:
+//   minimal   1 segment receive window,  2 frame receive queue, about 14 KB
+//   balanced  4 segment windows,         8 frame receive queue, about 29 KB
+//   bulk      8 segment windows,        16 frame receive queue, about 53 KB
+#define NET_PROFILE_MINIMAL             0
+#define NET_PROFILE_BALANCED            1
+#define NET_PROFILE_BULK                2
+
+#ifndef NET_PROFILE
+    #define NET_PROFILE                 NET_PROFILE_BALANCED
+#endif
+
+#if NET_PROFILE == NET_PROFILE_MINIMAL
+    #define NET_PROFILE_NAME            "minimal"
+    #define TCP_WND                     (TCP_MSS)
+    #define TCP_SND_BUF                 (2 * TCP_MSS)
+    #define PBUF_POOL_SIZE              4
+#elif NET_PROFILE == NET_PROFILE_BALANCED
+    #define NET_PROFILE_NAME            "balanced"
+    #define TCP_WND                     (4 * TCP_MSS)
+    #define TCP_SND_BUF                 (4 * TCP_MSS)
+    #define PBUF_POOL_SIZE              10
+#elif NET_PROFILE == NET_PROFILE_BULK
+    #define NET_PROFILE_NAME            "bulk"
+    #define TCP_WND                     (8 * TCP_MSS)
+    #define TCP_SND_BUF                 (8 * TCP_MSS)
+    #define PBUF_POOL_SIZE              18
+#else
+    #error "NET_PROFILE must be NET_PROFILE_MINIMAL, NET_PROFILE_BALANCED or NET_PROFILE_BULK"
+#endif
+
+// Sent data waits in heap pbufs until acknowledged, room for two connections sending at once
+#define MEM_SIZE                        (2 * TCP_SND_BUF + 2048)
+#define TCP_SND_QUEUELEN                ((4 * TCP_SND_BUF + (TCP_MSS - 1)) / TCP_MSS)
+#define MEMP_NUM_TCP_SEG                (TCP_SND_QUEUELEN + 8)
 
 #define ETHARP_SUPPORT_STATIC_ENTRIES   1
 
@@ -58,9 +94,18 @@
 //#define LWIP_HTTPD_FILE_STATE           1
 
 #define LWIP_HTTPD_CUSTOM_FILES         1
-//#define LWIP_HTTPD_DYNAMIC_FILE_READ    1
-//#define LWIP_HTTPD_FILE_EXTENSION       1
+#define LWIP_HTTPD_DYNAMIC_FILE_READ    1
+#define LWIP_HTTPD_FS_ASYNC_READ        1
+#define LWIP_HTTPD_FILE_EXTENSION       1
 #define LWIP_HTTPD_DYNAMIC_HEADERS      1
+// Custom file answers sit in render buffers and caches that are reused as soon as httpd
+// closes the file, which is before TCP has the data acked, so lwIP copies them. The pages
+// from fsdata stay in flash and still go out by reference.
+#define HTTP_IS_DATA_VOLATILE(hs)       ((((hs)->handle != NULL) && !(hs)->handle->is_custom_file && \
+                                          ((hs)->file == (const char *)(hs)->handle->data + (hs)->handle->len - (hs)->left)) \
+                                         ? 0 : TCP_WRITE_FLAG_COPY)
+// POST bodies only go to the /bench/upload sink
+#define LWIP_HTTPD_SUPPORT_POST         1
 
 //#ifndef LWIP_HTTPD_SSI
 //#define LWIP_HTTPD_SSI                  1
@@ -69,13 +114,26 @@
 //#define LWIP_HTTPD_SSI_MULTIPART        0
 //#endif
 #define HTTPD_USE_CUSTOM_FSDATA         0
-#define HTTPD_FSDATA_FILE               "pico_printer_fs.c"
+// Generated from fs_pokemon/ by regen-fsdata.sh, pico_printer_fs.c has the printer frontend
+#define HTTPD_FSDATA_FILE               "pokemon_storage_fs.c"
 
 #define HTTPD_ADDITIONAL_CONTENT_TYPES {"bin", HTTP_CONTENT_TYPE("application/pico-printer-binary-log")}
 
 #define LWIP_SINGLE_NETIF               1
 
-#define PBUF_POOL_SIZE                  2
+// PBUF_POOL_SIZE comes with the profile: one pbuf per frame of the USB receive queue
+// (NET_RX_QUEUE_DEPTH) and two for lwIP to hold on to
+// PBUF_REF pbufs over TinyUSB's receive buffer with NET_RX_ZERO_COPY (see tusb_lwip_glue.h).
+// An out of order segment would keep its tcphdr pointer into the driver's buffer after the
+// payload was copied out of it, so such segments are dropped and resent by the peer instead of
+// queued. Set with cmake -DNET_RX_ZERO_COPY=..., the tcp_pcb layout depends on it.
+#ifndef NET_RX_ZERO_COPY
+    #define NET_RX_ZERO_COPY            0
+#endif
+#if NET_RX_ZERO_COPY
+    #define TCP_QUEUE_OOSEQ             0
+#endif
+#define LWIP_SUPPORT_CUSTOM_PBUF        1
 #define LWIP_MULTICAST_PING             1
 #define LWIP_BROADCAST_PING             1
 #define LWIP_IPV6_MLD                   0
@@ -9,7 +9,7 @@
 #define POKEMON_DATA_SIZE 44  // Core Pokemon data (without nickname/OT name)
 #define POKEMON_NAME_LENGTH 11
 #define POKEMON_OT_NAME_LENGTH 11
-#define MAX_STORED_POKEMON 256
+#define MAX_STORED_POKEMON 1024 // multiple of 32, the storage takes 75 bytes a slot
 
 // Link Cable Protocol Bytes (Gen 1 Focus)
 #define PKMN_MASTER         0x01 // Master device identification
@@ -136,7 +136,7 @@ typedef struct {
     char ot_name[POKEMON_OT_NAME_LENGTH];          // Original trainer name (11 bytes, stored separately)
 } pokemon_data_t;
 
-// Storage slot for Pokemon
+// Storage slot for Pokemon, what pokemon_get_stored() hands out. The storage itself is packed.
 typedef struct {
     bool occupied;
     uint32_t timestamp;
@@ -171,6 +171,9 @@ typedef struct {
     // Buffer for receiving the partner's trade block
     trade_block_t incoming_trade_block_buffer; // Buffer to store the raw incoming trade block
     size_t incoming_pokemon_bytes_count;     // Counter for bytes received for the trade block
+
+    // Lookahead exchange: responses up to the end of the trade block are already queued
+    bool tx_preloaded;
 } trade_session_t;
 
 // Define for trade_exchange_sub_state values
@@ -0,0 +1,391 @@
+#include "lwip/apps/fs.h"
+#include "lwip/def.h"
+
+
+#define file_NULL (struct fsdata_file *) NULL
+
+
+#ifndef FS_FILE_FLAGS_HEADER_INCLUDED
+#define FS_FILE_FLAGS_HEADER_INCLUDED 1
+#endif
+#ifndef FS_FILE_FLAGS_HEADER_PERSISTENT
+#define FS_FILE_FLAGS_HEADER_PERSISTENT 0
+#endif
+/* FSDATA_FILE_ALIGNMENT: 0=off, 1=by variable, 2=by include */
+#ifndef FSDATA_FILE_ALIGNMENT
+#define FSDATA_FILE_ALIGNMENT 0
+#endif
+#ifndef FSDATA_ALIGN_PRE
+#define FSDATA_ALIGN_PRE
+#endif
+#ifndef FSDATA_ALIGN_POST
+#define FSDATA_ALIGN_POST
+#endif
+#if FSDATA_FILE_ALIGNMENT==2
+#include "fsdata_alignment.h"
+#endif
+#if FSDATA_FILE_ALIGNMENT==1
+static const unsigned int dummy_align__index_html = 0;
+#endif
+static const unsigned char FSDATA_ALIGN_PRE data__index_html[] FSDATA_ALIGN_POST = {
+/* /index.html (12 chars) */
+0x2f,0x69,0x6e,0x64,0x65,0x78,0x2e,0x68,0x74,0x6d,0x6c,0x00,
+
+/* HTTP header */
+/* "HTTP/1.0 200 OK
+" (17 bytes) */
+0x48,0x54,0x54,0x50,0x2f,0x31,0x2e,0x30,0x20,0x32,0x30,0x30,0x20,0x4f,0x4b,0x0d,
+0x0a,
+/* "Server: lwIP/2.2.1d (http://savannah.nongnu.org/projects/lwip)
+" (64 bytes) */
+0x53,0x65,0x72,0x76,0x65,0x72,0x3a,0x20,0x6c,0x77,0x49,0x50,0x2f,0x32,0x2e,0x32,
+0x2e,0x31,0x64,0x20,0x28,0x68,0x74,0x74,0x70,0x3a,0x2f,0x2f,0x73,0x61,0x76,0x61,
+0x6e,0x6e,0x61,0x68,0x2e,0x6e,0x6f,0x6e,0x67,0x6e,0x75,0x2e,0x6f,0x72,0x67,0x2f,
+0x70,0x72,0x6f,0x6a,0x65,0x63,0x74,0x73,0x2f,0x6c,0x77,0x69,0x70,0x29,0x0d,0x0a,
+
+/* "Content-Length: 1524
+" (18+ bytes) */
+0x43,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x2d,0x4c,0x65,0x6e,0x67,0x74,0x68,0x3a,0x20,
+0x31,0x35,0x32,0x34,0x0d,0x0a,
+/* "Content-Encoding: gzip
+" (24 bytes) */
+0x43,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x2d,0x45,0x6e,0x63,0x6f,0x64,0x69,0x6e,0x67,
+0x3a,0x20,0x67,0x7a,0x69,0x70,0x0d,0x0a,
+/* "ETag: "8c0a09b7"
+" (18 bytes) */
+0x45,0x54,0x61,0x67,0x3a,0x20,0x22,0x38,0x63,0x30,0x61,0x30,0x39,0x62,0x37,0x22,
+0x0d,0x0a,
+/* "Content-Type: text/html
+
+" (27 bytes) */
+0x43,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x2d,0x54,0x79,0x70,0x65,0x3a,0x20,0x74,0x65,
+0x78,0x74,0x2f,0x68,0x74,0x6d,0x6c,0x0d,0x0a,0x0d,0x0a,
+/* raw file data (1524 bytes) */
+0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x95,0x57,0xdb,0x72,0xdb,0x36,
+0x10,0x7d,0xf7,0x57,0x6c,0xda,0x4c,0x49,0x8e,0x75,0xf7,0xa5,0x1e,0x51,0x92,0xa7,
+0x6d,0x3c,0xbd,0x4c,0xda,0x64,0x1a,0xbf,0x74,0x32,0x1d,0x1b,0x22,0x41,0x11,0x09,
+0x44,0x70,0x00,0xc8,0x8a,0xea,0xe8,0x17,0xfa,0x0b,0xfd,0x83,0x7e,0x5b,0x3f,0xa1,
+0xbb,0x00,0x69,0x91,0x92,0xe3,0x36,0x2f,0x16,0x2e,0xbb,0x07,0x67,0x97,0x07,0xbb,
+0xf0,0xe4,0xd9,0x8b,0x57,0xdf,0x5d,0xff,0xf6,0xfa,0x0a,0x72,0xbb,0x94,0xb3,0xa3,
+0x89,0xfb,0x99,0xe4,0x9c,0xa5,0x38,0xb1,0xc2,0x4a,0x3e,0x7b,0xad,0xde,0xf3,0xa5,
+0x2a,0xe0,0x8d,0x55,0x9a,0x2d,0x38,0xbc,0xd9,0x18,0xcb,0x97,0x93,0xbe,0xdf,0x3d,
+0x9a,0x2c,0xb9,0x65,0x90,0xe4,0x4c,0x1b,0x6e,0xa7,0xc1,0xca,0x66,0xdd,0x8b,0xa0,
+0x5e,0x2e,0xd8,0x92,0x4f,0x83,0x3b,0xc1,0xd7,0xa5,0xd2,0x36,0x80,0x44,0x15,0x96,
+0x17,0x68,0xb6,0x16,0xa9,0xcd,0xa7,0x29,0xbf,0x13,0x09,0xef,0xba,0x49,0x07,0x44,
+0x21,0xac,0x60,0xb2,0x6b,0x12,0x26,0xf9,0x74,0x48,0x20,0xc6,0x6e,0xe8,0x8c,0xb9,
+0x4a,0x37,0x70,0x0f,0x19,0x7a,0x77,0x33,0xb6,0x14,0x72,0x33,0x86,0x6f,0x34,0xda,
+0x76,0xc0,0xb0,0xc2,0x74,0x0d,0xd7,0x22,0x8b,0x61,0xc9,0xf4,0x42,0x14,0x63,0x18,
+0x0d,0xca,0x0f,0x31,0xcc,0x59,0xf2,0x7e,0xa1,0xd5,0xaa,0x48,0xc7,0xf0,0x65,0x36,
+0xc8,0x2e,0x32,0x34,0xd9,0x1e,0xe5,0x43,0x44,0x4a,0x94,0x54,0x1a,0x97,0x87,0xfc,
+0x74,0xc0,0x70,0xd9,0xf2,0x0f,0xb6,0xcb,0xa4,0x58,0xa0,0x77,0x82,0x04,0xb9,0x26,
+0xd3,0x9e,0xb1,0xcc,0xae,0x0c,0xda,0xb7,0xb0,0xf8,0x20,0x1b,0x65,0x3c,0x86,0x92,
+0xa5,0xa9,0x28,0x16,0x63,0x18,0x9e,0xb9,0xf3,0x94,0x4e,0xb9,0xee,0x6a,0x96,0x8a,
+0x95,0x19,0xc3,0x05,0xad,0xd5,0x8c,0x86,0xc8,0x08,0x06,0x0e,0xb3,0xf4,0xe9,0xec,
+0x26,0x4c,0xa7,0xfb,0xc8,0x19,0x51,0xf4,0x38,0x18,0x05,0xba,0x18,0x25,0x45,0x8a,
+0xeb,0xf3,0x79,0x36,0x3a,0x3d,0x38,0x62,0xe8,0xe2,0xdc,0xa3,0xd1,0x3c,0x32,0x86,
+0x54,0x98,0x52,0x32,0x4c,0x97,0x28,0xa4,0x28,0x78,0x77,0x2e,0x55,0xf2,0x1e,0x8d,
+0x44,0xe1,0xb3,0x4e,0xc9,0x72,0x86,0x0d,0x66,0xf4,0xd1,0xea,0x6c,0xaf,0xb9,0x58,
+0xe4,0x76,0x8c,0x27,0xcb,0x34,0x7e,0x48,0x5b,0x9a,0x8c,0xce,0x47,0xe7,0xb1,0x37,
+0x31,0xe2,0x0f,0x8e,0xc7,0x5d,0xec,0xa1,0x88,0x22,0x53,0x88,0x52,0xd3,0x39,0xf3,
+0x09,0xa8,0x11,0x4e,0xbe,0x3e,0x1d,0x9e,0x0d,0x9d,0x83,0x54,0x8b,0x83,0x14,0x67,
+0x27,0xd9,0x69,0x76,0xde,0x8c,0x6d,0xf0,0x48,0x8a,0xab,0x78,0x3f,0x74,0xf3,0x8a,
+0x65,0x15,0x8b,0xba,0xe3,0x3a,0x93,0x6a,0xdd,0xc5,0xb8,0xd9,0xca,0xaa,0xb8,0xad,
+0x1c,0x64,0xa7,0x4c,0xc9,0x12,0xde,0x0e,0x60,0xe4,0x03,0x98,0xaf,0xac,0x45,0xb5,
+0xef,0x11,0x3a,0x99,0x5f,0x8c,0x88,0x50,0xc5,0x7f,0x9d,0x0b,0xcb,0x77,0x9f,0xaa,
+0x50,0x45,0x53,0x0f,0x98,0x0a,0x18,0x9e,0x7f,0x8a,0x70,0xb2,0xd2,0x86,0x30,0x4a,
+0x25,0xbc,0xd0,0x1a,0x29,0xda,0x11,0x18,0xe7,0x14,0xc5,0x3e,0x8d,0xd1,0xd9,0xf9,
+0x09,0x9f,0xbb,0xb4,0x69,0x9e,0x69,0x6e,0x72,0xb4,0x78,0x4c,0xbc,0xed,0xab,0xb0,
+0x3d,0x9a,0xf4,0xab,0xab,0x34,0xe9,0xbb,0xcb,0x3d,0xa1,0x2b,0x45,0xf7,0x7d,0x38,
+0xfb,0xe7,0xaf,0x3f,0xff,0x86,0xc7,0x2f,0x39,0xd0,0x1e,0x7a,0x0c,0xd1,0x32,0x15,
+0x77,0x90,0x48,0x66,0xcc,0x34,0xf0,0xd7,0x22,0x00,0x91,0x3e,0x8c,0x67,0x2f,0x15,
+0xa3,0xe0,0xc1,0xcf,0x7b,0xbd,0xde,0xa4,0x8f,0x1e,0x6d,0xbf,0x8a,0x72,0x80,0xa7,
+0xfb,0x24,0xab,0x22,0x91,0x22,0x79,0x3f,0x0d,0x24,0x7a,0xbf,0x60,0x96,0x85,0x51,
+0x30,0xfb,0xb5,0x0a,0x8c,0xe6,0x93,0xbe,0xb7,0x9c,0xd5,0x68,0xf9,0x68,0x46,0x14,
+0x79,0x5a,0x33,0x46,0x76,0xa3,0xea,0x14,0xa2,0x53,0xab,0x4f,0x0a,0x63,0x77,0xa4,
+0x2a,0xdb,0x06,0x2b,0x74,0xba,0xd6,0x7e,0xf3,0x25,0xea,0xaf,0x81,0x52,0x71,0x25,
+0x55,0xfa,0x08,0xdd,0xe8,0x01,0x8a,0x66,0x0d,0x1c,0x93,0x68,0x51,0xda,0xd9,0x11,
+0x16,0x36,0x63,0x01,0x4b,0x1e,0x6a,0x79,0x0a,0xf7,0xdb,0xf8,0x28,0x5b,0x15,0x89,
+0x15,0x18,0x64,0xc6,0x6d,0x92,0xff,0x64,0x54,0x11,0xae,0x34,0x16,0x2c,0xcd,0x0b,
+0x94,0x44,0x04,0xf7,0x47,0xe0,0xb7,0x42,0xe7,0xf5,0x16,0x37,0x7f,0x87,0x4b,0xc0,
+0x1f,0x38,0x86,0xe0,0x92,0x16,0xa7,0x01,0x0e,0x1b,0xbb,0x63,0xda,0x8d,0x7a,0x36,
+0xe7,0x45,0xa8,0x61,0x3a,0x73,0x18,0x00,0x22,0x83,0x50,0xd7,0xb5,0x6a,0x3a,0x85,
+0x93,0xc1,0x69,0x84,0xc7,0xd8,0x95,0x2e,0x62,0x67,0xd0,0x80,0x98,0x92,0x29,0x29,
+0x80,0x6b,0xd3,0x5b,0x70,0x1b,0x06,0x57,0xd7,0x6c,0x11,0x44,0xf0,0xf1,0x23,0x04,
+0x41,0x84,0xaa,0xc2,0x72,0x91,0xf0,0xb0,0xff,0x45,0x7f,0xd1,0xa1,0x15,0x8f,0xe0,
+0xd1,0x40,0xf7,0xde,0x51,0x1c,0x35,0x05,0x1f,0x09,0x59,0x6c,0xf1,0xef,0x76,0x17,
+0xb2,0xc9,0xd5,0xfa,0x8d,0xe3,0x13,0xa6,0xf8,0x15,0x7d,0xb0,0xa9,0x4a,0x56,0x4b,
+0x94,0x27,0x1d,0x7b,0x25,0x39,0x0d,0xbf,0xdd,0xfc,0x98,0x86,0xb5,0x84,0xa2,0x9e,
+0x28,0x0a,0xae,0x7f,0xb8,0xfe,0xf9,0x25,0xd2,0x74,0xc7,0xde,0x62,0x03,0xd0,0xaa,
+0x58,0xcc,0x3c,0xd8,0x98,0x54,0xec,0xe6,0xf0,0xfc,0x9e,0x80,0xab,0xa0,0x7b,0x16,
+0x3f,0x25,0xbf,0xa1,0x09,0xdf,0x4e,0xe6,0x7a,0x76,0x7b,0xbc,0xef,0xde,0x94,0xcc,
+0x27,0x61,0x8c,0x33,0xbb,0xa9,0x34,0xb4,0xed,0xb7,0x77,0x13,0x86,0x35,0x43,0xd8,
+0xcd,0xa3,0x27,0x5c,0x2b,0xcb,0x24,0x90,0xa4,0xf8,0x13,0x34,0xc9,0xe8,0xc6,0x91,
+0x35,0xdb,0x5b,0xca,0x98,0xe4,0x16,0x8c,0x54,0xd6,0x8b,0xa6,0xe3,0xd4,0x85,0xc3,
+0x20,0xe8,0xc0,0x82,0x17,0x38,0x2a,0x56,0x52,0xc6,0xed,0xc4,0x56,0x51,0x84,0x3e,
+0xab,0x84,0x40,0x4d,0xdb,0x79,0xd1,0xa7,0x78,0x35,0x7f,0xc7,0x13,0xdb,0xbb,0x63,
+0x72,0xc5,0x4d,0xe8,0xc0,0xa3,0x5e,0xa6,0xf4,0x15,0x43,0xa9,0x95,0x3b,0xd5,0x38,
+0xa7,0xe3,0x29,0x86,0xd0,0x50,0x7d,0xb3,0x39,0x05,0x75,0x90,0xf0,0xb8,0x0d,0xb5,
+0x89,0x60,0xf6,0xfc,0xbe,0xec,0x99,0x92,0x27,0x02,0x43,0xf2,0x97,0xe2,0x69,0x2f,
+0x6a,0x0b,0x78,0x9b,0xf8,0x1d,0x97,0x63,0x20,0x67,0x49,0xc3,0xcf,0x70,0xbd,0xde,
+0x94,0xdc,0x7b,0x5a,0x1c,0x0d,0xe9,0x2b,0xf9,0xe1,0xe8,0x73,0x40,0x34,0xc3,0x6e,
+0xa8,0x2b,0x1c,0x3f,0xf9,0x0c,0xf7,0xef,0x31,0x74,0xef,0xbb,0xc0,0xd1,0xa1,0xa3,
+0x9f,0xd7,0x17,0xe3,0x09,0xe9,0xb7,0xca,0x55,0xfb,0x02,0xb8,0xef,0x43,0xb7,0xf2,
+0x17,0xf5,0x50,0x9d,0xbd,0x40,0x61,0xc3,0x6d,0x2f,0x38,0xb8,0x70,0x54,0xc7,0xc2,
+0xff,0xb8,0x6a,0xae,0x96,0xb5,0xcf,0x71,0x92,0xab,0xce,0x71,0x63,0x76,0xc7,0x84,
+0x64,0x73,0xc9,0xf7,0xce,0xa0,0x1a,0xdd,0xd6,0xde,0xae,0xb2,0x05,0xfd,0x2a,0x12,
+0x57,0x20,0x50,0xbd,0x24,0x7b,0xa7,0xb5,0x86,0xbc,0x63,0xb7,0x5a,0x3f,0x10,0xf6,
+0x34,0xe9,0xaa,0xd8,0xb3,0xb2,0x97,0x72,0x54,0x34,0x4f,0x23,0xef,0xf7,0x16,0xc5,
+0x85,0xbf,0x54,0xb7,0xca,0x98,0x92,0xd9,0xbe,0x01,0xf1,0x7e,0xe1,0x21,0x8e,0x8d,
+0x3c,0x34,0x09,0xba,0xc2,0x7d,0xc0,0xae,0xba,0x70,0x8e,0x18,0x8d,0xe3,0x46,0x2a,
+0x1f,0x45,0xf7,0x5d,0xea,0x00,0xbd,0xba,0xe1,0x15,0xfe,0xae,0xfe,0xb9,0xcf,0xdf,
+0xca,0x5c,0xbd,0x50,0x9d,0x81,0xf8,0xfd,0x3e,0xe4,0x5c,0xa6,0x30,0xdf,0x00,0xd6,
+0x55,0xf0,0x8f,0x62,0x58,0x15,0x56,0x48,0x7c,0x00,0xe2,0x3b,0x3a,0xa7,0xc6,0x83,
+0x2f,0xec,0x62,0xc1,0x4d,0x07,0xf0,0xc1,0xbb,0xc6,0xea,0x0d,0x6b,0x61,0x73,0xe7,
+0x50,0xed,0x60,0x37,0x95,0x9b,0x1d,0xd9,0x52,0x49,0xd9,0x24,0x1a,0x52,0x41,0xb9,
+0x84,0xdb,0x3e,0xde,0xb7,0xc2,0x7a,0xaa,0x97,0x4e,0x50,0xd3,0xe7,0xf7,0xb8,0xe7,
+0xab,0xdf,0xf6,0x2b,0x57,0x45,0x1f,0x96,0xa8,0xa2,0x7e,0x85,0x89,0xa9,0x16,0x70,
+0xb4,0xbd,0xc5,0x3e,0x14,0x34,0x51,0x82,0xc8,0x09,0xbf,0xd1,0x97,0xea,0x3e,0x51,
+0x35,0x8a,0x74,0x57,0x75,0x7c,0xb7,0x7a,0x86,0x58,0x51,0x23,0x9d,0x71,0x63,0x2f,
+0xad,0xaa,0x65,0xd4,0xea,0x22,0xf5,0x62,0xdb,0xb2,0x92,0x12,0x35,0x3d,0x7c,0x5c,
+0x10,0x5e,0x10,0x1d,0x66,0xdb,0xb5,0x40,0x69,0x78,0xdb,0x09,0x53,0x03,0xe9,0x53,
+0x62,0x6c,0x68,0xd1,0x0f,0xda,0x92,0x8c,0x3d,0xe6,0xff,0x94,0x69,0x8b,0x36,0x09,
+0xed,0x66,0x29,0x8c,0x21,0xec,0xa6,0x16,0x0e,0xb8,0x92,0x65,0xb4,0x93,0x69,0xe8,
+0x7e,0x8f,0xa1,0xda,0xc0,0x43,0x51,0x29,0x61,0x77,0x78,0x7e,0x72,0x71,0x1a,0xed,
+0x49,0xb7,0x02,0xf3,0x6d,0xe4,0xde,0x97,0x8e,0x31,0xa4,0xfe,0x33,0x77,0xdc,0x3b,
+0xad,0x9a,0xe3,0xc0,0x75,0x9e,0xb1,0xc7,0x85,0x6d,0x4d,0xc4,0x4b,0xc8,0xcf,0xb6,
+0x11,0x36,0x40,0x92,0x11,0x6a,0x0a,0x53,0x84,0xff,0xeb,0x5d,0x8b,0x25,0x57,0x2b,
+0x1b,0x92,0x55,0x87,0x9e,0xde,0x83,0xc8,0xc9,0xb9,0xf6,0xc2,0x2e,0x58,0x3d,0x8e,
+0xf0,0x15,0x47,0xaf,0x4d,0x7c,0x64,0xb9,0x7f,0x32,0xff,0x05,0x1f,0x2e,0x8c,0x0c,
+0x75,0x0e,0x00,0x00,};
+
+#if FSDATA_FILE_ALIGNMENT==1
+static const unsigned int dummy_align__realtime_test_html = 1;
+#endif
+static const unsigned char FSDATA_ALIGN_PRE data__realtime_test_html[] FSDATA_ALIGN_POST = {
+/* /realtime_test.html (20 chars) */
+0x2f,0x72,0x65,0x61,0x6c,0x74,0x69,0x6d,0x65,0x5f,0x74,0x65,0x73,0x74,0x2e,0x68,
+0x74,0x6d,0x6c,0x00,
+
+/* HTTP header */
+/* "HTTP/1.0 200 OK
+" (17 bytes) */
+0x48,0x54,0x54,0x50,0x2f,0x31,0x2e,0x30,0x20,0x32,0x30,0x30,0x20,0x4f,0x4b,0x0d,
+0x0a,
+/* "Server: lwIP/2.2.1d (http://savannah.nongnu.org/projects/lwip)
+" (64 bytes) */
+0x53,0x65,0x72,0x76,0x65,0x72,0x3a,0x20,0x6c,0x77,0x49,0x50,0x2f,0x32,0x2e,0x32,
+0x2e,0x31,0x64,0x20,0x28,0x68,0x74,0x74,0x70,0x3a,0x2f,0x2f,0x73,0x61,0x76,0x61,
+0x6e,0x6e,0x61,0x68,0x2e,0x6e,0x6f,0x6e,0x67,0x6e,0x75,0x2e,0x6f,0x72,0x67,0x2f,
+0x70,0x72,0x6f,0x6a,0x65,0x63,0x74,0x73,0x2f,0x6c,0x77,0x69,0x70,0x29,0x0d,0x0a,
+
+/* "Content-Length: 2725
+" (18+ bytes) */
+0x43,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x2d,0x4c,0x65,0x6e,0x67,0x74,0x68,0x3a,0x20,
+0x32,0x37,0x32,0x35,0x0d,0x0a,
+/* "Content-Encoding: gzip
+" (24 bytes) */
+0x43,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x2d,0x45,0x6e,0x63,0x6f,0x64,0x69,0x6e,0x67,
+0x3a,0x20,0x67,0x7a,0x69,0x70,0x0d,0x0a,
+/* "ETag: "4f0bf395"
+" (18 bytes) */
+0x45,0x54,0x61,0x67,0x3a,0x20,0x22,0x34,0x66,0x30,0x62,0x66,0x33,0x39,0x35,0x22,
+0x0d,0x0a,
+/* "Content-Type: text/html
+
+" (27 bytes) */
+0x43,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x2d,0x54,0x79,0x70,0x65,0x3a,0x20,0x74,0x65,
+0x78,0x74,0x2f,0x68,0x74,0x6d,0x6c,0x0d,0x0a,0x0d,0x0a,
+/* raw file data (2725 bytes) */
+0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xad,0x59,0xdb,0x72,0xdb,0xc8,
+0x11,0x7d,0xe7,0x57,0x8c,0x6b,0x9d,0x05,0x50,0x02,0x41,0x52,0xb2,0x1c,0x2d,0x40,
+0x70,0xcb,0x96,0xbd,0xb5,0xde,0xc8,0x96,0xcb,0x92,0x73,0x29,0x45,0x25,0x0d,0x81,
+0x01,0x89,0x15,0x88,0x41,0x0d,0x06,0xa4,0x18,0x98,0xaf,0x79,0xcc,0x43,0x7e,0x20,
+0x7f,0x90,0x8f,0xca,0x17,0xe4,0x13,0xd2,0x3d,0xb8,0xf3,0xe2,0x55,0x6a,0xb7,0x5c,
+0x65,0x13,0x73,0xe9,0xee,0x39,0xdd,0x7d,0xba,0x67,0x3c,0x7e,0xf6,0xe6,0xf2,0xfc,
+0xfa,0x2f,0x1f,0xdf,0x92,0xb9,0x5c,0x44,0x93,0xde,0x58,0xfd,0x33,0x9e,0x33,0xea,
+0xc3,0x87,0x0c,0x65,0xc4,0x26,0x1f,0xf9,0x03,0x5b,0xf0,0x98,0x5c,0x0b,0xea,0x87,
+0xf1,0x8c,0x7c,0x14,0x5c,0x72,0x8f,0x47,0xa4,0x4f,0x3e,0x31,0x1a,0xf5,0x65,0xb8,
+0x60,0xe4,0x3d,0x8f,0x43,0xc9,0xc5,0x78,0x50,0xec,0xe9,0x8d,0x17,0x4c,0x52,0xe2,
+0xcd,0xa9,0x48,0x99,0x74,0xb5,0x4c,0x06,0xfd,0x33,0xad,0x1a,0x8e,0xe9,0x82,0xb9,
+0xda,0x32,0x64,0xab,0x84,0x0b,0xa9,0x11,0x8f,0xc7,0x92,0xc5,0xb0,0x6c,0x15,0xfa,
+0x72,0xee,0xfa,0x6c,0x19,0x7a,0xac,0xaf,0x3e,0x4c,0x12,0x82,0xe0,0x10,0xd4,0xa4,
+0x1e,0x8d,0x98,0x3b,0x42,0x21,0xa9,0x5c,0xa3,0x8e,0x29,0xf7,0xd7,0x79,0x00,0x7b,
+0xfb,0x01,0x5d,0x84,0xd1,0xda,0xd6,0xce,0x79,0x26,0x42,0x26,0xc8,0x07,0xb6,0xd2,
+0x4c,0xb0,0x99,0xa7,0x09,0xf5,0x98,0x33,0xa5,0xde,0xc3,0x4c,0xf0,0x2c,0xf6,0xed,
+0x6f,0x46,0x14,0xff,0x38,0x60,0x3f,0x17,0xf6,0x37,0xc3,0x61,0x10,0x0c,0x87,0xce,
+0x82,0x8a,0x59,0x18,0xdb,0x43,0x27,0xa1,0x3e,0x9e,0xd1,0x3e,0x1e,0x26,0x8f,0x9b,
+0x9e,0x85,0x86,0xd1,0x30,0x66,0x22,0x5f,0xd0,0xc7,0xc2,0x20,0x7b,0x74,0x3c,0x84,
+0xc9,0x7a,0x0b,0xa1,0x99,0xe4,0x9b,0xde,0x7c,0x94,0x4b,0xf6,0x28,0xfb,0x34,0x0a,
+0x67,0xb1,0xed,0xc1,0x69,0x98,0x68,0x2b,0x09,0x02,0x47,0xcd,0xa7,0x73,0xea,0xf3,
+0x15,0x6c,0x1b,0x92,0x11,0x88,0x21,0xe5,0x24,0xe8,0x4a,0x25,0x95,0x59,0x9a,0xb7,
+0x6d,0x3d,0xa6,0xf8,0xc7,0x99,0x72,0xe1,0x33,0x61,0x1f,0xc3,0xf2,0x94,0x47,0xa1,
+0x4f,0x2a,0xb3,0x8b,0x89,0x3e,0xfa,0x25,0x4b,0x6d,0x94,0x57,0x1f,0x60,0x74,0x5a,
+0xdb,0xd8,0x9f,0x72,0x29,0xf9,0x42,0x9d,0xc9,0xd9,0x31,0xb2,0xd6,0x8c,0x87,0x8d,
+0x99,0x27,0x99,0x9f,0x97,0x72,0xbb,0x18,0x4d,0xf9,0x63,0xdb,0x7a,0x94,0x46,0xc4,
+0x6c,0x4a,0xf5,0xa1,0x79,0x7c,0x7a,0x6a,0x0e,0xcd,0xa1,0x75,0x62,0x34,0xd2,0xfc,
+0x30,0x3d,0x24,0x10,0xc5,0x81,0xc0,0xee,0xd7,0x41,0xf1,0xa5,0xf0,0x4a,0x7c,0xc4,
+0x67,0xfd,0xc6,0x2d,0x6d,0xb4,0x86,0x35,0x22,0x6d,0xa8,0x4e,0x4e,0x4e,0xf6,0xe1,
+0x34,0x67,0xe1,0x6c,0x2e,0xed,0x17,0xca,0x97,0x7c,0xc9,0x44,0x10,0xf1,0x55,0x7f,
+0x6d,0xa3,0x37,0xbb,0x20,0xaa,0x00,0x4b,0xc3,0xbf,0x31,0x7b,0xf4,0x02,0x3e,0x23,
+0xd0,0xdb,0x2f,0x77,0x8f,0xac,0x17,0xa5,0x45,0x00,0xa5,0x58,0xe7,0x5d,0xbc,0x4f,
+0x5b,0xee,0x38,0x01,0x83,0x86,0xed,0xb5,0x56,0x52,0x66,0x51,0xde,0x0d,0x12,0xa5,
+0x6d,0x55,0x88,0x9f,0xf2,0xc8,0xef,0xec,0x91,0x70,0x02,0x96,0xd7,0xb8,0x21,0x72,
+0x9d,0x79,0x26,0x04,0x17,0xf9,0x16,0xae,0x0d,0x42,0x5b,0x70,0x8e,0x8c,0xda,0x3c,
+0x34,0xb5,0x04,0x29,0x62,0x81,0x54,0xe6,0x96,0xf8,0x15,0x62,0x3a,0x6a,0xd2,0x75,
+0x2a,0xd9,0xa2,0xad,0x47,0x05,0x30,0x7a,0x45,0xf0,0x28,0xcd,0x9f,0x18,0x76,0x53,
+0x19,0x77,0xfc,0x87,0x9e,0xda,0x0e,0xb9,0x03,0x81,0x5f,0x3b,0x08,0xa3,0xe4,0xb8,
+0x93,0x8e,0xca,0xbb,0x5e,0x26,0x52,0x90,0x93,0xf0,0x50,0xe5,0x61,0xd7,0xff,0xb5,
+0x53,0x4b,0xd6,0x08,0xe3,0x39,0x13,0xa1,0x2c,0x2c,0xb2,0xe7,0x18,0x0c,0x5b,0x71,
+0xa5,0x74,0xd6,0xa6,0x0d,0xcb,0x20,0x4f,0x73,0x88,0xf1,0x24,0xa2,0x6b,0x7b,0x26,
+0x42,0xdf,0xc1,0xbf,0xfa,0x80,0x0b,0x8c,0x48,0x86,0xa1,0x9e,0x2d,0xe2,0xd4,0x16,
+0x2c,0x61,0x54,0xea,0x18,0x56,0xfd,0x20,0x94,0xe6,0x22,0x8c,0x81,0x4a,0x74,0xc5,
+0x21,0xe6,0x28,0x10,0x86,0xe1,0xcc,0x68,0x72,0x28,0x5d,0x4b,0x4d,0x7d,0x8f,0x0a,
+0xff,0x2b,0xcc,0x30,0x6a,0x00,0x3a,0x3d,0x3d,0xdd,0x3a,0xee,0xd9,0x36,0x2b,0x1c,
+0xa2,0x80,0xfe,0x92,0x46,0x19,0xcb,0x9b,0x78,0x3f,0x7e,0x51,0x21,0xd5,0x0a,0xc8,
+0x2e,0xa9,0x55,0x5b,0x23,0x3a,0x65,0x75,0x28,0x53,0x4a,0xdb,0x59,0x73,0xdc,0x1c,
+0x4d,0xf2,0x04,0xe1,0xdf,0xf4,0xc6,0x83,0x92,0xc3,0xc7,0x03,0x55,0x6b,0xc6,0xc8,
+0xe5,0xf0,0xe5,0x87,0x4b,0xe2,0x45,0x34,0x4d,0x5d,0xad,0x4e,0x72,0x64,0xfc,0xf9,
+0x68,0xf2,0xdf,0x7f,0xfd,0xe3,0xdf,0xe4,0x60,0x2d,0x2a,0xeb,0x0f,0xc1,0x55,0x20,
+0x73,0xd4,0x95,0x55,0x70,0x92,0x46,0x42,0x5f,0xc9,0x45,0x56,0x0a,0x79,0x7c,0x55,
+0x8c,0x4e,0xce,0xcb,0x11,0x90,0x27,0x39,0xf9,0x13,0x9b,0x5e,0x71,0xef,0x81,0x49,
+0xcb,0xb2,0xc6,0x03,0x10,0xb2,0x2b,0x2a,0xd5,0x76,0xc7,0x94,0x8f,0xb4,0xc9,0xce,
+0xb0,0x02,0xb5,0xd0,0x5c,0xa5,0x3c,0x54,0xa9,0x58,0x6a,0x93,0x61,0x21,0x7d,0x67,
+0x87,0xc2,0x52,0x9b,0x34,0x47,0x63,0x69,0x4a,0x67,0x2c,0x2d,0x97,0xef,0x37,0xe9,
+0x09,0xea,0x15,0x7b,0x3c,0x4d,0x37,0xc2,0xcb,0xc8,0xdb,0x25,0x84,0xc7,0xaf,0x56,
+0xab,0x48,0xe9,0x69,0x6a,0xdf,0xe2,0xd2,0x5f,0xad,0xb0,0x71,0xf0,0x35,0x74,0x26,
+0xda,0xa4,0xdf,0xff,0xba,0xd6,0xf3,0xaa,0x4c,0x11,0x5c,0xdf,0xd5,0xbe,0x6b,0x44,
+0xc5,0x72,0x18,0x02,0xd3,0x0c,0x32,0x35,0xae,0x66,0x80,0x3d,0x34,0xc2,0x63,0x2f,
+0x0a,0xbd,0x07,0x58,0x17,0x31,0x2a,0x2e,0xf8,0x4c,0x37,0x40,0x03,0xfe,0x26,0xf0,
+0x31,0x1e,0x14,0x5b,0x7e,0x61,0xaf,0xe4,0xb3,0x59,0xc4,0x5e,0x01,0x67,0x5c,0x79,
+0xa0,0x2b,0x42,0x19,0xd7,0x6a,0x8c,0xe0,0x20,0xb4,0x42,0x38,0xfa,0x44,0x61,0x50,
+0x51,0xe3,0x88,0x53,0xbf,0xb4,0xe5,0x4d,0xf9,0xb9,0x65,0xce,0xee,0x41,0x3b,0x85,
+0xb6,0x40,0x16,0x86,0xce,0xdb,0x59,0xb9,0xb5,0x5a,0x55,0x07,0x52,0x54,0x07,0x6d,
+0x72,0xa5,0xfe,0x25,0x80,0xb4,0x50,0xa9,0x95,0x25,0xad,0x84,0xea,0x80,0x0c,0xc7,
+0x09,0x13,0x39,0xe9,0x45,0x4c,0x92,0x55,0xea,0xc6,0x59,0x14,0x99,0xb4,0x3e,0xbc,
+0x2b,0x45,0xc6,0xcc,0x4e,0xee,0xb8,0x43,0xb3,0x09,0x66,0xf8,0x68,0x42,0x0c,0x3e,
+0x3a,0xf9,0x2d,0x24,0xfa,0xb4,0x10,0x09,0x26,0xbe,0x05,0x0b,0x43,0x96,0xba,0x37,
+0xb7,0x26,0x98,0x2d,0x2f,0xc2,0xf8,0x01,0x49,0x00,0xec,0xd7,0xcc,0x08,0x3f,0xbc,
+0x39,0x5b,0x50,0xb5,0xdc,0xe9,0x05,0x59,0xac,0xc4,0x90,0x52,0x62,0x4d,0x0c,0xba,
+0x91,0xf7,0xb0,0xdc,0xf7,0xd0,0x58,0xb6,0x6a,0x18,0x43,0xd7,0x56,0xa9,0x3d,0x18,
+0x8c,0xbe,0x3b,0xb6,0x46,0x2f,0xcf,0xac,0xdf,0x5b,0x23,0xfb,0x6c,0x78,0x36,0xd4,
+0xcc,0x1b,0x2d,0x09,0x3d,0xde,0x47,0x15,0xd6,0x72,0xa4,0xdd,0x1a,0xce,0x2a,0xb5,
+0xa6,0x61,0x4c,0xc5,0xfa,0x7a,0x9d,0x40,0x2f,0x4c,0x85,0xa0,0xeb,0x69,0x16,0x04,
+0x00,0xac,0x03,0x72,0x2d,0xe8,0x5d,0x13,0x16,0xbb,0x95,0x0d,0x3a,0x33,0x80,0x5d,
+0x63,0x20,0x79,0x86,0x85,0x58,0xd7,0x6a,0x9d,0xa4,0xee,0xb2,0x34,0xc3,0xd9,0x77,
+0xf6,0x37,0x50,0x8e,0xac,0x98,0xaf,0x74,0xc3,0xc9,0x12,0x1f,0x3e,0xce,0xb7,0x08,
+0x50,0xd7,0x9a,0x0c,0x68,0xb7,0xf4,0x8b,0x82,0x52,0xd1,0x77,0x14,0x96,0x2f,0x99,
+0x66,0xa2,0x2b,0x0c,0x07,0x8a,0xc9,0x45,0x81,0xe5,0x5a,0xd7,0x4a,0x77,0x9b,0xfb,
+0x2c,0x22,0x69,0xe6,0x79,0xc0,0x5e,0x01,0xe0,0xb9,0xd6,0x8c,0x4d,0x79,0xb2,0x45,
+0x41,0x68,0x9d,0xc3,0x21,0x9e,0x61,0xa0,0x33,0x0b,0x2c,0xa4,0xd0,0xf3,0x43,0xd8,
+0xc4,0x1e,0xe3,0x01,0x79,0x85,0xc8,0xbc,0x56,0xc8,0x18,0xf9,0x9c,0xc6,0x7e,0xc4,
+0xd0,0x6d,0x3f,0x08,0xb8,0x43,0x94,0xcb,0x0d,0x47,0x30,0x99,0x89,0x78,0x83,0x08,
+0x49,0x82,0x43,0xee,0x4f,0x57,0x97,0x1f,0xac,0x04,0x6f,0x1f,0xf5,0xa2,0x62,0x73,
+0x6d,0x66,0x49,0xab,0xba,0x9a,0xdc,0x78,0x54,0x7a,0x73,0x1d,0x02,0xa9,0xc1,0x59,
+0x45,0x95,0xae,0x29,0x52,0x22,0x28,0x0a,0x91,0x68,0x4e,0x59,0x9e,0xc2,0xd6,0x30,
+0xfc,0xb6,0x40,0x51,0x5b,0x01,0x93,0x1f,0x68,0x18,0x01,0x0c,0x50,0x55,0x94,0x29,
+0x7b,0x76,0x13,0xed,0x08,0x16,0x5b,0xe5,0xa7,0xb1,0xa9,0x30,0xf2,0x22,0x9e,0xb2,
+0xa7,0xb8,0xbf,0xdd,0x67,0x6b,0x87,0x5d,0xfc,0xa6,0xb5,0x0c,0xbc,0xfc,0x4a,0x62,
+0xa7,0x52,0x95,0x3c,0xc1,0xca,0x39,0xc8,0x50,0xcd,0x0c,0x68,0x94,0x3e,0xc1,0xcb,
+0x6d,0xc5,0x26,0xa1,0x87,0x05,0x1a,0x0e,0x5c,0x01,0x31,0x14,0x79,0x26,0xf5,0xed,
+0x5c,0x32,0x4f,0xa0,0xa1,0xaa,0x23,0x43,0xe1,0xb6,0xf7,0xd4,0xa5,0x33,0x1a,0xf5,
+0x6a,0x00,0xc1,0x3f,0x00,0xfd,0xd6,0x4a,0xc2,0x3d,0x68,0x0a,0x05,0x62,0x04,0xca,
+0x2a,0x77,0xef,0xc8,0x6f,0x1c,0xe6,0x09,0xe8,0xdb,0x5a,0x1e,0x2b,0x54,0xfd,0x42,
+0x06,0x21,0x5b,0x04,0x85,0x08,0xcc,0x24,0x30,0x08,0x00,0x69,0x83,0xfa,0xcb,0x48,
+0x6c,0x1a,0xde,0xd9,0x8e,0x76,0xe0,0x07,0x60,0x1e,0xc8,0x92,0x67,0x0d,0x57,0x19,
+0x45,0xe8,0x3b,0x45,0xe8,0x2f,0x15,0x1f,0x41,0xc6,0xd3,0x3f,0xc2,0xe5,0x5a,0x6d,
+0x70,0x60,0xfd,0xd2,0x9a,0x31,0xf9,0x19,0x7a,0xe1,0x33,0x7d,0x68,0x3c,0x73,0xdd,
+0x66,0xbb,0xf5,0x10,0xc6,0x7e,0x25,0xa3,0x57,0x08,0x89,0xdd,0x7a,0xfd,0xe8,0xa5,
+0x7e,0x5c,0x24,0xbd,0x89,0x94,0x00,0x49,0xb9,0x48,0x2a,0x15,0x4c,0x37,0x2c,0xc9,
+0x2f,0x38,0x5e,0xcb,0xf1,0x4c,0x57,0x12,0xa9,0x42,0x37,0xcc,0x39,0x7b,0x74,0xa7,
+0xee,0x44,0x1b,0x3e,0x6a,0x47,0x53,0x58,0x52,0x4e,0x8c,0x5e,0xe2,0xfa,0xcf,0x49,
+0xc2,0xc4,0x39,0x4d,0x71,0x37,0x74,0xa5,0x8a,0xa6,0x40,0x87,0x36,0x84,0x30,0xe9,
+0x05,0xe0,0x02,0x2c,0x02,0x21,0xd0,0x38,0x6f,0x5b,0x89,0x3d,0x22,0x13,0x77,0xd8,
+0x4f,0x3a,0xe1,0x38,0x76,0xc2,0xa3,0x23,0x93,0x1f,0xb5,0x57,0x60,0xc4,0x09,0x5f,
+0xad,0x28,0x9c,0x2a,0xa1,0xf2,0xb4,0x17,0x60,0xc5,0x67,0xe9,0x4d,0x0b,0x0a,0x6e,
+0xdc,0x7e,0xf9,0xd2,0xf9,0x76,0x7a,0x9d,0x32,0x73,0x74,0xd4,0x0d,0xad,0x6a,0x52,
+0x33,0xef,0x6f,0x9e,0xe7,0x35,0x20,0x9b,0x5b,0xf2,0xf1,0xd3,0xe5,0xf5,0xe5,0xf9,
+0xe5,0x85,0x4d,0x3e,0xfd,0xd9,0x26,0xcf,0x73,0x80,0xa0,0x0d,0x3a,0x3f,0x1a,0x19,
+0xc6,0x86,0xfc,0xe7,0xef,0xff,0x24,0xd7,0xfb,0xe7,0x8f,0x71,0x5e,0x7f,0x9e,0xa7,
+0x72,0x63,0xdc,0xc3,0x35,0xb7,0x88,0x33,0x55,0x9b,0x74,0x63,0x27,0x24,0xf6,0x73,
+0x58,0x5e,0xfa,0xef,0xc9,0x9e,0x72,0x7a,0xe9,0x2a,0xc4,0x3c,0xc0,0xed,0x96,0x84,
+0x42,0x84,0x32,0xc0,0x37,0xa4,0x39,0xaa,0xfd,0x1b,0x21,0xa2,0x54,0x88,0xc7,0x36,
+0x08,0x85,0xd6,0x47,0x75,0x6e,0xf5,0x5b,0xb9,0x08,0xcf,0xef,0x4c,0x21,0xf9,0x1e,
+0x9c,0x2d,0x5b,0xee,0x52,0xe5,0x49,0xcd,0x6e,0x55,0x6a,0xdc,0xb7,0x9f,0xa9,0xb6,
+0x0d,0x7a,0xad,0xaa,0x2d,0xc1,0xbd,0xf8,0x2c,0x05,0xb9,0x17,0x55,0x36,0xa4,0xd9,
+0xb4,0xd2,0xb1,0x39,0xa8,0x7c,0x8a,0x8c,0xa1,0xd9,0x18,0xa2,0x05,0xcc,0x09,0x81,
+0xea,0xa4,0xf6,0x33,0xd5,0x27,0x1b,0xf9,0x6f,0x04,0x55,0xb2,0x85,0x53,0x52,0x81,
+0x94,0x34,0x08,0x6d,0x3a,0x46,0xaa,0x66,0xe8,0x4e,0x99,0xa1,0xd9,0x4d,0x67,0xb4,
+0x6d,0x82,0x9a,0xd9,0xd5,0x5f,0xa2,0xa0,0xb6,0x6f,0x6a,0xc7,0x94,0x15,0x69,0x17,
+0x90,0xe2,0x06,0x76,0x57,0x44,0xa8,0x66,0x3f,0x09,0xfc,0xea,0xda,0xa6,0x8a,0x7b,
+0xb1,0xd3,0xdf,0x16,0x5c,0xdc,0xd1,0xfe,0x3f,0xb9,0x05,0xfd,0x1e,0x92,0x88,0xbe,
+0xbe,0x2b,0xee,0x6b,0x76,0xc5,0x09,0x2a,0x62,0xac,0x26,0xdc,0xd2,0x2f,0x5f,0x6e,
+0x6e,0x4b,0xf6,0x94,0x6e,0x6a,0x2d,0x68,0xa2,0x3f,0xba,0x93,0xfb,0xe7,0xf9,0x63,
+0x89,0x36,0x59,0xc1,0x9d,0x44,0x12,0x1c,0x50,0xbf,0xee,0xb2,0x74,0x03,0x3a,0xf1,
+0x96,0xaf,0x06,0xf1,0x07,0xa0,0x64,0xfd,0xcc,0xc3,0x58,0xd7,0x4c,0x82,0x44,0x06,
+0x9c,0x2b,0xbf,0xfd,0x56,0x22,0xd5,0xb6,0xdb,0x4c,0x23,0xef,0x76,0x9d,0xf2,0x69,
+0xa1,0x7b,0xf1,0xee,0xc3,0x1f,0xd0,0x2f,0x12,0xd4,0x6c,0x2a,0xcf,0xfb,0x2c,0xa0,
+0x59,0x24,0x9f,0x86,0xd3,0xe7,0xf8,0x01,0x3a,0xc0,0xb8,0xea,0x3a,0x08,0xe6,0x7a,
+0x93,0x82,0xf0,0xb1,0xf9,0x1a,0xe9,0xb4,0x55,0xe0,0x62,0xb3,0xea,0x56,0x2a,0xc6,
+0x69,0xdf,0x0b,0x5c,0x9f,0x7b,0xd9,0x02,0x42,0x09,0xe9,0xed,0x6d,0xc4,0xf0,0xe7,
+0xeb,0xf5,0x3b,0x5f,0xef,0xde,0x1e,0x0c,0xa7,0xd9,0xab,0x24,0x37,0xfb,0x8a,0xca,
+0x5b,0x6e,0xd5,0x35,0xb8,0x23,0xe0,0xea,0x6a,0x9d,0xa5,0x2e,0x1c,0x1f,0xf0,0x05,
+0xf9,0xbe,0xb9,0x74,0xc0,0x71,0xd5,0x29,0x9c,0x7a,0x19,0xbe,0x72,0x9c,0x97,0xef,
+0xca,0xa5,0xbd,0x4a,0x48,0x6d,0x82,0x45,0xa1,0x14,0xc5,0xfe,0xf9,0x3c,0x8c,0x7c,
+0xbd,0xda,0x66,0x38,0xcd,0x2d,0xc1,0x4a,0xb2,0x74,0xae,0xe7,0xed,0x13,0x37,0x55,
+0xd0,0x6e,0xda,0xea,0x4d,0xe1,0xf0,0xd6,0xc6,0x88,0xc5,0x33,0x39,0x9f,0x8c,0xb0,
+0xa0,0xe7,0xad,0xf1,0x74,0x1e,0x06,0x70,0x7b,0x70,0x3a,0x66,0x08,0xc8,0x8c,0x25,
+0xab,0xcd,0x68,0x26,0x82,0x10,0xa2,0x4d,0x8d,0x83,0x33,0x40,0x41,0x73,0x25,0x32,
+0x3a,0xeb,0x8a,0xdb,0xe0,0x35,0x4f,0xdc,0x3d,0xc3,0x3f,0xaa,0x97,0x9b,0x22,0x22,
+0xf1,0xa6,0xe1,0x96,0x17,0x72,0xcd,0xc8,0x9b,0x5b,0x13,0x10,0x45,0xd7,0xf7,0x2d,
+0xe7,0x1f,0xe8,0x78,0x2a,0x40,0xea,0x16,0xb0,0x0e,0x86,0x22,0x8f,0x4b,0xf7,0x1d,
+0x8e,0x86,0x9d,0x67,0x18,0x2c,0x47,0xed,0xad,0x7b,0x3d,0xd8,0x5d,0xd1,0x84,0x42,
+0x6d,0xc6,0xf7,0x25,0x8f,0xb4,0xae,0x45,0x76,0x35,0xd4,0x69,0x95,0x77,0x8e,0x58,
+0x9e,0x3d,0xef,0x1d,0x34,0xb9,0xfb,0x7e,0x63,0x74,0x0c,0xec,0xcc,0x39,0x87,0x65,
+0xb4,0x1e,0x61,0xba,0x02,0x9a,0x89,0xaf,0xec,0x6e,0xbd,0xa5,0x74,0x77,0x37,0x13,
+0xca,0xd5,0x7b,0xee,0x81,0xb5,0x7f,0x58,0x44,0x93,0x94,0xf9,0xee,0x7b,0x2a,0xe7,
+0x56,0x10,0x71,0x28,0x68,0x7a,0x13,0xcc,0xfd,0x7d,0x5b,0x07,0x2a,0x92,0xab,0x8c,
+0x5d,0x84,0x71,0x06,0xc4,0xd9,0x16,0x50,0xca,0x1c,0xbc,0x1c,0x1a,0x25,0x97,0xa6,
+0x78,0x03,0xf0,0x53,0xb7,0x9c,0xf9,0xdd,0xcb,0xe1,0x57,0x8e,0xb5,0xf5,0x62,0xd3,
+0x3d,0x1a,0x50,0x71,0xa9,0x71,0x63,0x43,0x83,0x54,0xc8,0x6d,0xda,0xca,0x9d,0x36,
+0x72,0x73,0xdf,0x0e,0xdf,0xe6,0x19,0x26,0x7f,0x22,0x31,0x59,0x21,0x18,0x23,0x7e,
+0xbc,0x7e,0x7f,0xe1,0x6a,0x9a,0xd3,0x79,0x34,0x70,0xb6,0x5e,0x21,0x9c,0xf6,0x2b,
+0x84,0xd3,0x7e,0x85,0xe8,0xe6,0xd3,0x81,0xbb,0x14,0x0c,0x15,0xf6,0xa9,0x5b,0x49,
+0x63,0xf3,0xee,0xf3,0x4f,0xde,0x7a,0x0e,0x79,0xd6,0xfc,0x3e,0x50,0x3e,0x5a,0x6f,
+0x44,0x40,0x8c,0xcd,0xf2,0xef,0x35,0x16,0xd3,0x69,0xa4,0x52,0x02,0x72,0xa1,0xf8,
+0xa9,0x98,0xbf,0x56,0xdd,0x79,0x2c,0x6a,0xd1,0xfb,0x35,0x38,0xc4,0x6d,0x31,0x19,
+0x96,0x49,0xc5,0xbc,0x50,0x2a,0xa1,0xd6,0xd4,0x8d,0x66,0xf9,0xff,0x14,0x15,0x4b,
+0x36,0x7d,0x67,0xe5,0x2d,0xd5,0x6f,0x94,0xab,0x80,0x8f,0xba,0x37,0x02,0xd5,0x7d,
+0x14,0x93,0x4d,0xfb,0x51,0x16,0xd6,0xbf,0xc6,0x4d,0xcd,0x98,0x46,0x7c,0xaa,0x9a,
+0xdb,0xd7,0xf0,0x43,0xbf,0x29,0xed,0xbb,0x35,0x15,0x57,0xdb,0x1a,0x46,0xcf,0x20,
+0x89,0xc0,0x9f,0xda,0xa6,0x8a,0xc7,0x4c,0x44,0xee,0xe7,0x4f,0x17,0x65,0x71,0xb9,
+0x9c,0xfe,0x0c,0xf1,0x06,0xdf,0x3a,0x8a,0xaa,0xe5,0xd2,0x83,0x45,0x88,0x82,0x72,
+0xb8,0x86,0x08,0x16,0xb8,0x20,0x09,0x7e,0x56,0x40,0xb9,0xf7,0x55,0x43,0x24,0x8b,
+0x27,0xe9,0x3b,0xb0,0xe6,0xae,0x85,0x08,0x42,0xf0,0xee,0xea,0xb2,0x8e,0xd6,0x34,
+0x0a,0x3d,0xa6,0x0f,0xcd,0xd1,0x77,0x06,0x50,0x3f,0x58,0x09,0x5f,0x03,0x7b,0x30,
+0x33,0xb5,0x3e,0x04,0x01,0xb4,0x7a,0xf2,0x1e,0xc4,0xab,0xb7,0x3b,0x08,0x1c,0x34,
+0x59,0xb0,0x25,0xa8,0x68,0x4c,0x06,0x03,0xc0,0x65,0x70,0x93,0x7c,0x87,0x8f,0xf7,
+0x4b,0x1a,0xe9,0xad,0x60,0x33,0x8b,0x54,0xdd,0x7d,0xb2,0x72,0xf0,0xcd,0xbd,0x78,
+0x68,0x1b,0x0f,0xd4,0x6b,0xfb,0x78,0x50,0xfc,0x9f,0xef,0xff,0x00,0x56,0xd2,0x01,
+0x23,0x04,0x1e,0x00,0x00,};
+
+
+
+const struct fsdata_file file__index_html[] = { {
+file_NULL,
+data__index_html,
+data__index_html + 12,
+sizeof(data__index_html) - 12,
+FS_FILE_FLAGS_HEADER_INCLUDED | FS_FILE_FLAGS_HEADER_PERSISTENT,
+}};
+
+const struct fsdata_file file__realtime_test_html[] = { {
+file__index_html,
+data__realtime_test_html,
+data__realtime_test_html + 20,
+sizeof(data__realtime_test_html) - 20,
+FS_FILE_FLAGS_HEADER_INCLUDED | FS_FILE_FLAGS_HEADER_PERSISTENT,
+}};
+
+#define FS_ROOT file__realtime_test_html
+#define FS_NUMFILES 2
+
@@ -4,6 +4,14 @@
 #include <stddef.h>
 #include "pokemon_data.h"
 #include "linkcable.h"
+#include "slot_bitmap.h"
+
+// Lookahead exchange mode: as soon as the trade preamble starts, every response up to the
+// last trade block byte is queued into the link TX ring, so it sits in the PIO TX FIFO before
+// the Game Boy clocks the byte that needs it. Requires the DMA ring buffers.
+#ifndef POKEMON_TRADE_TX_LOOKAHEAD
+#define POKEMON_TRADE_TX_LOOKAHEAD LINKCABLE_USE_DMA
+#endif
 
 // Trading protocol responses
 #define TRADE_RESPONSE_SUCCESS 0x00
@@ -22,8 +30,11 @@ void pokemon_send_trade_response(uint8_t response_code);
 
 // Storage management
 bool pokemon_store_received(const pokemon_data_t* pokemon, const char* source_game);
-pokemon_slot_t* pokemon_get_stored_list(void);
+bool pokemon_commit_trade(const pokemon_data_t* pokemon, const char* source_game);  // store and release the traded slot
+bool pokemon_get_stored(size_t index, pokemon_slot_t* slot);   // copy of a taken slot, false when it is empty
 size_t pokemon_get_stored_count(void);
+const uint32_t* pokemon_get_occupancy(void);    // SLOT_BITMAP_WORDS(MAX_STORED_POKEMON) words, bit per taken slot
+size_t pokemon_next_stored(size_t index);       // first taken slot from index on, MAX_STORED_POKEMON after the last
 bool pokemon_delete_stored(size_t index);
 bool pokemon_send_stored(size_t index);
 
@@ -32,8 +43,19 @@ trade_state_t pokemon_get_trade_state(void);
 const char* pokemon_get_last_error(void);
 trade_session_t* pokemon_get_current_session(void);
 
-// Diagnostic functions
+// Generation counters of what the web endpoints show, a response rendered at one generation
+// stays valid until the counter moves on
+typedef enum {
+    POKEMON_RESOURCE_STORE,         // pokemon_store_received(), pokemon_delete_stored()
+    POKEMON_RESOURCE_STATE,         // trade state transitions
+    POKEMON_RESOURCE_LOG,           // pokemon_log_trade_event() and every other trade log record
+    POKEMON_RESOURCE_COUNT
+} pokemon_resource_t;
+
+uint32_t pokemon_get_generation(pokemon_resource_t resource);
+uint32_t pokemon_get_slot_generation(size_t index);     // store generation of the slot's last change
+
+// Diagnostic functions, both strings have to be literals (the log keeps the pointers, see trade_log.h)
 void pokemon_log_trade_event(const char* event, const char* details);
-const char* pokemon_get_trade_log(void);
 
 #endif // POKEMON_TRADING_H 
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef _SLOT_BITMAP_H_INCLUDE_
+#define _SLOT_BITMAP_H_INCLUDE_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Occupancy bitmap of a fixed slot table, one bit per slot, set while the slot is taken.
+// Finding a free slot and walking the taken ones go a 32 slot word at a time with count
+// trailing zeros, the count is a popcount, so the cost follows the taken slots, not the table.
+// Bits past the last slot are never set.
+#define SLOT_BITMAP_WORDS(slots)    (((slots) + 31) / 32)
+
+static inline void slot_bitmap_set(uint32_t * bitmap, size_t slot) {
+    bitmap[slot / 32] |= 1u << (slot % 32);
+}
+
+static inline void slot_bitmap_clear(uint32_t * bitmap, size_t slot) {
+    bitmap[slot / 32] &= ~(1u << (slot % 32));
+}
+
+static inline bool slot_bitmap_test(const uint32_t * bitmap, size_t slot) {
+    return (bitmap[slot / 32] >> (slot % 32)) & 1;
+}
+
+// Lowest free slot, slots when all are taken
+static inline size_t slot_bitmap_first_clear(const uint32_t * bitmap, size_t slots) {
+    for (size_t w = 0; w < SLOT_BITMAP_WORDS(slots); w++) {
+        uint32_t free = ~bitmap[w];
+        if (!free) continue;
+        size_t slot = w * 32 + __builtin_ctz(free);
+        return (slot < slots) ? slot : slots;
+    }
+    return slots;
+}
+
+// Lowest taken slot from slot on, slots when there is none
+static inline size_t slot_bitmap_next_set(const uint32_t * bitmap, size_t slots, size_t slot) {
+    if (slot >= slots) return slots;
+    size_t w = slot / 32;
+    uint32_t word = bitmap[w] & (~0u << (slot % 32));
+    while (!word) {
+        if (++w >= SLOT_BITMAP_WORDS(slots)) return slots;
+        word = bitmap[w];
+    }
+    return w * 32 + __builtin_ctz(word);
+}
+
+static inline size_t slot_bitmap_count(const uint32_t * bitmap, size_t slots) {
+    size_t count = 0;
+    for (size_t w = 0; w < SLOT_BITMAP_WORDS(slots); w++) count += __builtin_popcount(bitmap[w]);
+    return count;
+}
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef _SPSC_QUEUE_H_INCLUDE_
+#define _SPSC_QUEUE_H_INCLUDE_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "hardware/sync.h"
+
+// Lock-free single producer / single consumer queue of fixed size items, used to pass
+// data between the two cores. head is only written by the producer, tail only by the
+// consumer, the barriers order the item copy against the index update on both sides.
+// The depth has to be a power of two, the indices run freely and are masked on access.
+typedef struct {
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    uint32_t mask;
+    size_t item_size;
+    uint8_t * items;
+} spsc_queue_t;
+
+#define SPSC_QUEUE_DEFINE(name, type, depth)                                                \
+    _Static_assert(((depth) & ((depth) - 1)) == 0, #name " depth must be a power of two"); \
+    static type name##_items[depth];                                                        \
+    static spsc_queue_t name = { 0, 0, (depth) - 1, sizeof(type), (uint8_t *)name##_items }
+
+static inline size_t spsc_queue_count(const spsc_queue_t * queue) {
+    return queue->head - queue->tail;
+}
+
+static inline bool spsc_queue_push(spsc_queue_t * queue, const void * item) {
+    uint32_t head = queue->head;
+    if ((head - queue->tail) > queue->mask) return false;
+    memcpy(&queue->items[(head & queue->mask) * queue->item_size], item, queue->item_size);
+    __dmb();
+    queue->head = head + 1;
+    return true;
+}
+
+// Copies the oldest item without taking it out of the queue
+static inline bool spsc_queue_peek(const spsc_queue_t * queue, void * item) {
+    uint32_t tail = queue->tail;
+    if (queue->head == tail) return false;
+    __dmb();
+    memcpy(item, &queue->items[(tail & queue->mask) * queue->item_size], queue->item_size);
+    return true;
+}
+
+static inline bool spsc_queue_pop(spsc_queue_t * queue, void * item) {
+    uint32_t tail = queue->tail;
+    if (queue->head == tail) return false;
+    __dmb();
+    memcpy(item, &queue->items[(tail & queue->mask) * queue->item_size], queue->item_size);
+    __dmb();
+    queue->tail = tail + 1;
+    return true;
+}
+
+#endif
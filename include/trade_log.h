@@ -0,0 +1,64 @@
+#ifndef _TRADE_LOG_H_INCLUDE_
+#define _TRADE_LOG_H_INCLUDE_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "pokemon_data.h"
+
+// Trade event log: a ring of fixed size binary records, cheap enough to write for every byte
+// from the link interrupt. Nothing is formatted when an event is logged, the text is rendered
+// when /logs.json or the USB "logs" command reads it. Records carry a free running sequence
+// number, the ring keeps the last TRADE_LOG_DEPTH of them.
+#define TRADE_LOG_DEPTH     256     // power of two
+
+// Meaning of the record fields per event
+typedef enum {
+    TRADE_EVENT_TEXT,               // category, text: string literals
+    TRADE_EVENT_RAW_RX,             // rx
+    TRADE_EVENT_GPIO,               // rx: SCK, tx: SIN, arg: SOUT
+    TRADE_EVENT_PROTOCOL,           // rx -> tx, counter: save sequence or exchange counter, arg: sub state
+    TRADE_EVENT_UNEXPECTED,         // rx -> tx
+    TRADE_EVENT_PREAMBLE,           // rx, counter: preamble bytes so far
+    TRADE_EVENT_RANDOM,             // rx, counter: random number and block preamble bytes so far
+    TRADE_EVENT_EXCHANGE,           // rx -> tx, counter: trade block byte
+    TRADE_EVENT_CONFIRM,            // rx: unknown byte during the confirmation
+    TRADE_EVENT_PREPARED,           // rx: species, arg: level of our trade block
+    TRADE_EVENT_RECEIVED,           // rx: species, arg: level parsed from the partner block
+    TRADE_EVENT_COMPLETED,          // rx: species, arg: level
+    TRADE_EVENT_SENT,               // rx: species, arg: level
+    TRADE_EVENT_STORED,             // rx: species, arg: level, counter: slot
+    TRADE_EVENT_DELETED,            // rx: species, counter: slot
+    TRADE_EVENT_BLOCK_SENT,         // rx: species of the block sent on request
+    TRADE_EVENT_COUNT
+} trade_event_id_t;
+
+typedef struct {
+    uint64_t time_us;
+    const char * category;
+    const char * text;
+    uint16_t counter;
+    uint8_t id;
+    uint8_t state;                  // trade_state_t when the event was logged
+    uint8_t rx;
+    uint8_t tx;
+    uint8_t arg;
+} trade_event_t;
+
+void trade_log_init(void);
+
+void trade_log_event(trade_event_id_t id, trade_state_t state, uint8_t rx, uint8_t tx, uint16_t counter, uint8_t arg);
+void trade_log_text(trade_state_t state, const char * category, const char * text);
+
+// Sequence numbers of the oldest record still in the ring and of the next one to be written
+uint32_t trade_log_first(void);
+uint32_t trade_log_end(void);
+
+// Copies a record out of the ring, false when it was overwritten already or not written yet
+bool trade_log_read(uint32_t seq, trade_event_t * event);
+
+// Renders one record as a text line including the newline, returns the length written
+size_t trade_log_render(const trade_event_t * event, char * buffer, size_t size);
+
+#endif
@@ -12,11 +12,44 @@
 #include "lwip/timeouts.h"
 #include "lwip/apps/httpd.h"
 
+/* received frames waiting for service_traffic(), each holds a PBUF_POOL buffer,
+   lwipopts.h leaves two more for lwip to hold on to */
+#define NET_RX_QUEUE_DEPTH  (PBUF_POOL_SIZE - 2)
+
+/* Zero copy receive (NET_RX_ZERO_COPY in lwipopts.h): lwip gets the frame in TinyUSB's
+   receive buffer as a PBUF_REF pbuf, and the driver receives the next one once lwip freed
+   it. The driver has one buffer, so only one frame is in flight and the queue above never
+   holds more than that one. A frame lwip keeps around is copied out after all, for the
+   wrappers in use that way plus one. Set to 0 to copy every frame into the queue, which
+   lets a burst of frames in while lwip is busy. */
+#define NET_RX_ZERO_COPY_FRAMES 4
+
+typedef struct {
+    uint32_t frames;        /* frames queued for lwip */
+    uint32_t dropped;       /* queued frames thrown away when the network re-initialized */
+    uint32_t held;          /* times reception paused with the queue or pbuf pool full */
+    uint32_t high_water;    /* most frames waiting at once */
+    uint32_t copied;        /* zero copy frames lwip kept, copied out of the USB buffer */
+} net_rx_stats_t;
+
+/* frames lwip sent while the USB IN endpoint was busy, a full queue is ERR_MEM for TCP */
+#define NET_TX_QUEUE_DEPTH  8
+
+typedef struct {
+    uint32_t sent;          /* frames handed to the driver */
+    uint32_t queued;        /* frames that had to wait for the endpoint */
+    uint32_t full;          /* frames refused with ERR_MEM */
+    uint32_t dropped;       /* queued frames thrown away when the network re-initialized */
+    uint32_t high_water;    /* most frames waiting at once */
+} net_tx_stats_t;
+
 void init_lwip(void);
 void wait_for_netif_is_up(void);
 void dhcpd_init(void);
 void dns_init(void);
 void service_traffic(void);
+const net_rx_stats_t *net_get_rx_stats(void);
+const net_tx_stats_t *net_get_tx_stats(void);
 
 #ifdef __cplusplus
  }
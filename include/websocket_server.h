@@ -7,6 +7,7 @@
 #include "lwip/err.h"
 #include "lwip/tcp.h"
 #include "lwip/pbuf.h"
+#include "pokemon_data.h"
 
 // WebSocket frame opcodes
 #define WS_OPCODE_CONTINUATION 0x00
@@ -24,12 +25,63 @@ typedef enum {
     WS_STATE_CLOSING
 } ws_state_t;
 
+// Binary link traffic channel, negotiated as a WebSocket subprotocol. Such a client first
+// gets a "protocol_schema" text message, then the protocol events as binary frames:
+//   frame header: u8 kind (WS_LINK_FRAME_EVENTS), u8 reserved, u16 record count, u32 time of the first record in us
+//   record:       u8 trade state, u8 rx, u8 tx, u16 us since the previous record (saturates at 0xFFFF)
+// All values little endian. Clients without the subprotocol keep getting "protocol_batch" JSON.
+#define WS_SUBPROTOCOL_LINK_BINARY  "pico-link.v1"
+#define WS_LINK_FRAME_EVENTS        0x01
+#define WS_LINK_FRAME_HEADER_SIZE   8
+#define WS_LINK_RECORD_SIZE         5
+
+// Outbound frames are queued whole in a per-connection ring and handed to lwIP as far as
+// tcp_sndbuf() allows, the rest goes out from the tcp_sent and tcp_poll callbacks.
+// A frame that does not fit the free ring space is dropped whole and counted, so a slow
+// client loses complete messages instead of stalling the others or corrupting its stream.
+#define WS_TX_RING_SIZE         8192    // power of two, fits the largest JSON batch
+#define WS_POLL_INTERVAL        2       // tcp_poll in 500 ms units, retries a stalled ring
+
+typedef struct {
+    uint32_t frames;                // queued
+    uint32_t frames_dropped;        // did not fit the ring
+    uint32_t bytes_dropped;
+    uint32_t stalls;                // tcp_write refused, retried later
+} ws_tx_stats_t;
+
+// Inbound frames are parsed incrementally over pbuf chains and recv callbacks. Payloads are
+// unmasked straight into per-connection buffers, fragmented messages are reassembled there.
+// A message larger than WS_RX_MESSAGE_SIZE closes the connection with WS_CLOSE_TOO_BIG,
+// a malformed frame with WS_CLOSE_PROTOCOL_ERROR.
+#define WS_RX_MESSAGE_SIZE      2048
+#define WS_RX_CONTROL_SIZE      125     // RFC 6455 limit for control frame payloads
+#define WS_CLOSE_PROTOCOL_ERROR 1002
+#define WS_CLOSE_TOO_BIG        1009
+
 // WebSocket connection structure
 typedef struct ws_connection {
     struct tcp_pcb *pcb;
     ws_state_t state;
+    bool binary_link;               // negotiated WS_SUBPROTOCOL_LINK_BINARY
     uint32_t last_ping_time;
     bool ping_pending;
+    uint32_t tx_head;               // free running ring indices
+    uint32_t tx_tail;
+    ws_tx_stats_t tx_stats;
+    uint8_t tx_ring[WS_TX_RING_SIZE];
+    uint8_t rx_header[14];          // frame header collected so far
+    uint8_t rx_header_len;
+    uint8_t rx_header_need;         // header size once known, 0 while in the payload
+    uint8_t rx_opcode;              // of the frame being received
+    bool rx_final;
+    uint8_t rx_mask[4];
+    uint8_t rx_mask_phase;
+    uint64_t rx_remaining;          // payload bytes of the frame still to come
+    uint8_t rx_message_opcode;      // text/binary message being reassembled, 0 for none
+    uint16_t rx_message_len;
+    uint8_t rx_control_len;
+    uint8_t rx_control[WS_RX_CONTROL_SIZE];
+    uint8_t rx_message[WS_RX_MESSAGE_SIZE];
     struct ws_connection *next;
 } ws_connection_t;
 
@@ -53,11 +105,21 @@ void websocket_send_text(ws_connection_t *conn, const char *message);
 void websocket_send_binary(ws_connection_t *conn, const uint8_t *data, size_t length);
 void websocket_close_connection(ws_connection_t *conn);
 size_t websocket_get_connection_count(void);
+const ws_tx_stats_t *websocket_get_tx_stats(void);     // totals over all connections since boot
+
+// Protocol events are only queued here, O(1) and safe from the link interrupt or core 1.
+// websocket_server_process() sends everything queued since the last batch every
+// WS_PROTOCOL_BATCH_INTERVAL_MS, up to WS_PROTOCOL_BATCH_MAX events per frame.
+#define WS_PROTOCOL_QUEUE_DEPTH         256     // power of two
+#define WS_PROTOCOL_BATCH_INTERVAL_MS   50
+#define WS_PROTOCOL_BATCH_MAX           64
 
 // Real-time trading event broadcasting
 void websocket_broadcast_trade_event(const char *event_type, const char *message);
-void websocket_broadcast_protocol_data(uint8_t rx_byte, uint8_t tx_byte, const char *state);
+void websocket_broadcast_protocol_data(uint8_t rx_byte, uint8_t tx_byte, trade_state_t state);
+uint32_t websocket_get_dropped_protocol_events(void);
 void websocket_broadcast_pokemon_data(const char *pokemon_json);
 void websocket_broadcast_status_update(const char *status_json);
+void websocket_broadcast_link_stats(void);
 
 #endif // WEBSOCKET_SERVER_H 
\ No newline at end of file
@@ -65,7 +65,11 @@ tdefl_compressor g_deflator;
 #endif /* MAKEFS_SUPPORT_DEFLATE_ZLIB */
 
 static int deflate_level; /* default compression level, can be changed via command line */
+#if MAKEFS_SUPPORT_DEFLATE_ZLIB
+#define USAGE_ARG_DEFLATE " [-defl<:compr_level>] [-gzip<:compr_level>]"
+#else
 #define USAGE_ARG_DEFLATE " [-defl<:compr_level>]"
+#endif
 #else /* MAKEFS_SUPPORT_DEFLATE */
 #define USAGE_ARG_DEFLATE ""
 #endif /* MAKEFS_SUPPORT_DEFLATE */
@@ -131,7 +135,7 @@ struct file_entry {
 int process_sub(FILE *data_file, FILE *struct_file);
 int process_file(FILE *data_file, FILE *struct_file, const char *filename);
 int file_write_http_header(FILE *data_file, const char *filename, int file_size, u16_t *http_hdr_len,
-                           u16_t *http_hdr_chksum, u8_t provide_content_len, int is_compressed);
+                           u16_t *http_hdr_chksum, u8_t provide_content_len, int is_compressed, u32_t etag);
 int file_put_ascii(FILE *file, const char *ascii_string, int len, int *i);
 int s_put_ascii(char *buf, const char *ascii_string, int len, int *i);
 void concat_files(const char *file1, const char *file2, const char *targetfile);
@@ -154,8 +158,10 @@ static unsigned char useHttp11 = 0;
 static unsigned char supportSsi = 1;
 static unsigned char precalcChksum = 0;
 static unsigned char includeLastModified = 0;
+static unsigned char includeETag = 0;
 #if MAKEFS_SUPPORT_DEFLATE
 static unsigned char deflateNonSsiFiles = 0;
+static unsigned char gzipNonSsiFiles = 0;
 static size_t deflatedBytesReduced = 0;
 static size_t overallDataBytes = 0;
 #endif
@@ -171,7 +177,7 @@ static size_t ssi_file_num_lines;
 
 static void print_usage(void)
 {
-  printf(" Usage: htmlgen [targetdir] [-s] [-e] [-11] [-nossi] [-ssi:<filename>] [-c] [-f:<filename>] [-m] [-svr:<name>] [-x:<ext_list>] [-xc:<ext_list>" USAGE_ARG_DEFLATE NEWLINE NEWLINE);
+  printf(" Usage: htmlgen [targetdir] [-s] [-e] [-11] [-nossi] [-ssi:<filename>] [-c] [-f:<filename>] [-m] [-etag] [-svr:<name>] [-x:<ext_list>] [-xc:<ext_list>" USAGE_ARG_DEFLATE NEWLINE NEWLINE);
   printf("   targetdir: relative or absolute path to files to convert" NEWLINE);
   printf("   switch -s: toggle processing of subdirectories (default is on)" NEWLINE);
   printf("   switch -e: exclude HTTP header from file (header is created at runtime, default is off)" NEWLINE);
@@ -181,12 +187,16 @@ static void print_usage(void)
   printf("   switch -c: precalculate checksums for all pages (default is off)" NEWLINE);
   printf("   switch -f: target filename (default is \"fsdata.c\")" NEWLINE);
   printf("   switch -m: include \"Last-Modified\" header based on file time" NEWLINE);
+  printf("   switch -etag: include \"ETag\" header with a hash of the file data" NEWLINE);
   printf("   switch -svr: server identifier sent in HTTP response header ('Server' field)" NEWLINE);
   printf("   switch -x: comma separated list of extensions of files to exclude (e.g., -x:json,txt)" NEWLINE);
   printf("   switch -xc: comma separated list of extensions of files to not compress (e.g., -xc:mp3,jpg)" NEWLINE);
 #if MAKEFS_SUPPORT_DEFLATE
   printf("   switch -defl: deflate-compress all non-SSI files (with opt. compr.-level, default=10)" NEWLINE);
   printf("                 ATTENTION: browser has to support \"Content-Encoding: deflate\"!" NEWLINE);
+#if MAKEFS_SUPPORT_DEFLATE_ZLIB
+  printf("   switch -gzip: like -defl, but gzip-compressed and sent with \"Content-Encoding: gzip\"" NEWLINE);
+#endif
 #endif
   printf("   if targetdir not specified, htmlgen will attempt to" NEWLINE);
   printf("   process files in subdirectory 'fs'" NEWLINE);
@@ -245,9 +255,19 @@ int main(int argc, char *argv[])
         printf("Writing to file \"%s\"\n", targetfile);
       } else if (!strcmp(argv[i], "-m")) {
         includeLastModified = 1;
-      } else if (strstr(argv[i], "-defl") == argv[i]) {
+      } else if (!strcmp(argv[i], "-etag")) {
+        includeETag = 1;
+      } else if ((strstr(argv[i], "-defl") == argv[i]) || (strstr(argv[i], "-gzip") == argv[i])) {
 #if MAKEFS_SUPPORT_DEFLATE
         const char *colon = &argv[i][5];
+        if (argv[i][1] == 'g') {
+#if MAKEFS_SUPPORT_DEFLATE_ZLIB
+          gzipNonSsiFiles = 1;
+#else
+          printf("ERROR: gzip needs MAKEFS_SUPPORT_DEFLATE_ZLIB" NEWLINE);
+          exit(0);
+#endif
+        }
         if (*colon == ':') {
           int defl_level = atoi(&colon[1]);
           if ((colon[1] != 0) && (defl_level >= 0) && (defl_level <= 10)) {
@@ -261,7 +281,8 @@ int main(int argc, char *argv[])
           deflate_level = 10;
         }
         deflateNonSsiFiles = 1;
-        printf("Deflating all non-SSI files with level %d (but only if size is reduced)" NEWLINE, deflate_level);
+        printf("%s all non-SSI files with level %d (but only if size is reduced)" NEWLINE,
+               gzipNonSsiFiles ? "Gzipping" : "Deflating", deflate_level);
 #else
         printf("WARNING: Deflate support is disabled\n");
 #endif
@@ -565,6 +586,60 @@ int process_sub(FILE *data_file, FILE *struct_file)
   return filesProcessed;
 }
 
+#if MAKEFS_SUPPORT_DEFLATE_ZLIB
+/* like compress2()/uncompress2(), but with gzip framing for "Content-Encoding: gzip" */
+static int gzip_compress(Bytef *dest, uLongf *destLen, const Bytef *source, uLong sourceLen, int level)
+{
+  z_stream stream;
+  int status;
+  memset(&stream, 0, sizeof(stream));
+  /* zlib levels end at 9, -defl allows 10 for miniz */
+  status = deflateInit2(&stream, my_min(level, Z_BEST_COMPRESSION), Z_DEFLATED, 15 + 16, 9, Z_DEFAULT_STRATEGY);
+  if (status != Z_OK) {
+    return status;
+  }
+  stream.next_in = (Bytef *)source;
+  stream.avail_in = (uInt)sourceLen;
+  stream.next_out = dest;
+  stream.avail_out = (uInt)*destLen;
+  status = deflate(&stream, Z_FINISH);
+  *destLen = stream.total_out;
+  deflateEnd(&stream);
+  return (status == Z_STREAM_END) ? Z_OK : Z_BUF_ERROR;
+}
+
+static int gzip_uncompress(Bytef *dest, uLongf *destLen, const Bytef *source, uLong *sourceLen)
+{
+  z_stream stream;
+  int status;
+  memset(&stream, 0, sizeof(stream));
+  status = inflateInit2(&stream, 15 + 16);
+  if (status != Z_OK) {
+    return status;
+  }
+  stream.next_in = (Bytef *)source;
+  stream.avail_in = (uInt)*sourceLen;
+  stream.next_out = dest;
+  stream.avail_out = (uInt)*destLen;
+  status = inflate(&stream, Z_FINISH);
+  *destLen = stream.total_out;
+  *sourceLen = stream.total_in;
+  inflateEnd(&stream);
+  return (status == Z_STREAM_END) ? Z_OK : Z_DATA_ERROR;
+}
+#endif /* MAKEFS_SUPPORT_DEFLATE_ZLIB */
+
+/* FNV-1a over the data as sent, for the ETag header */
+static u32_t file_hash(const u8_t *data, size_t len)
+{
+  u32_t hash = 2166136261u;
+  size_t i;
+  for (i = 0; i < len; i++) {
+    hash = (hash ^ data[i]) * 16777619u;
+  }
+  return hash;
+}
+
 static u8_t *get_file_data(const char *filename, int *file_size, int can_be_compressed, int *is_compressed)
 {
   FILE *inFile;
@@ -625,7 +700,11 @@ static u8_t *get_file_data(const char *filename, int *file_size, int can_be_comp
           exit(-1);
         }
 #else /* MAKEFS_SUPPORT_DEFLATE_ZLIB */
-        status = compress2(next_out, &out_bytes, next_in, in_bytes, deflate_level);
+        if (gzipNonSsiFiles) {
+          status = gzip_compress(next_out, &out_bytes, next_in, in_bytes, deflate_level);
+        } else {
+          status = compress2(next_out, &out_bytes, next_in, in_bytes, deflate_level);
+        }
         if (status != Z_OK) {
           printf("deflate failed: %d\n", status);
           exit(-1);
@@ -651,7 +730,11 @@ static u8_t *get_file_data(const char *filename, int *file_size, int can_be_comp
             LWIP_ASSERT("tinfl_decompress failed", dec_status == TINFL_STATUS_DONE);
 #else /* MAKEFS_SUPPORT_DEFLATE_ZLIB */
             int dec_status;
-            dec_status = uncompress2 (s_checkbuf, &dec_out_bytes, ret_buf, &dec_in_bytes);
+            if (gzipNonSsiFiles) {
+              dec_status = gzip_uncompress(s_checkbuf, &dec_out_bytes, ret_buf, &dec_in_bytes);
+            } else {
+              dec_status = uncompress2 (s_checkbuf, &dec_out_bytes, ret_buf, &dec_in_bytes);
+            }
             LWIP_ASSERT("tinfl_decompress failed", dec_status == Z_OK);
 #endif /* MAKEFS_SUPPORT_DEFLATE_ZLIB */
             LWIP_ASSERT("tinfl_decompress size mismatch", fsize == dec_out_bytes);
@@ -1009,7 +1092,8 @@ int process_file(FILE *data_file, FILE *struct_file, const char *filename)
   can_be_compressed = includeHttpHeader && !is_ssi && file_can_be_compressed(filename);
   file_data = get_file_data(filename, &file_size, can_be_compressed, &is_compressed);
   if (includeHttpHeader) {
-    file_write_http_header(data_file, filename, file_size, &http_hdr_len, &http_hdr_chksum, has_content_len, is_compressed);
+    file_write_http_header(data_file, filename, file_size, &http_hdr_len, &http_hdr_chksum, has_content_len, is_compressed,
+                           file_hash(file_data, file_size));
     flags |= FS_FILE_FLAGS_HEADER_INCLUDED;
     if (has_content_len) {
       flags |= FS_FILE_FLAGS_HEADER_PERSISTENT;
@@ -1077,7 +1161,7 @@ int process_file(FILE *data_file, FILE *struct_file, const char *filename)
 }
 
 int file_write_http_header(FILE *data_file, const char *filename, int file_size, u16_t *http_hdr_len,
-                           u16_t *http_hdr_chksum, u8_t provide_content_len, int is_compressed)
+                           u16_t *http_hdr_chksum, u8_t provide_content_len, int is_compressed, u32_t etag)
 {
   int i = 0;
   int response_type = HTTP_HDR_OK;
@@ -1244,16 +1328,35 @@ int file_write_http_header(FILE *data_file, const char *filename, int file_size,
   if (is_compressed) {
     /* tell the client about the deflate encoding */
     LWIP_ASSERT("error", deflateNonSsiFiles);
-    cur_string = "Content-Encoding: deflate\r\n";
+    cur_string = gzipNonSsiFiles ? "Content-Encoding: gzip\r\n" : "Content-Encoding: deflate\r\n";
     cur_len = strlen(cur_string);
     fprintf(data_file, NEWLINE "/* \"%s\" (%d bytes) */" NEWLINE, cur_string, cur_len);
     written += file_put_ascii(data_file, cur_string, cur_len, &i);
     i = 0;
+    if (precalcChksum) {
+      memcpy(&hdr_buf[hdr_len], cur_string, cur_len);
+      hdr_len += cur_len;
+    }
   }
 #else
   LWIP_UNUSED_ARG(is_compressed);
 #endif
 
+  if (includeETag) {
+    /* content hash of the data as sent, changes whenever the file does */
+    char etagbuf[32];
+    snprintf(etagbuf, sizeof(etagbuf), "ETag: \"%08x\"\r\n", (unsigned int)etag);
+    cur_string = etagbuf;
+    cur_len = strlen(cur_string);
+    fprintf(data_file, NEWLINE "/* \"%s\" (%"SZT_F" bytes) */" NEWLINE, cur_string, cur_len);
+    written += file_put_ascii(data_file, cur_string, cur_len, &i);
+    i = 0;
+    if (precalcChksum) {
+      memcpy(&hdr_buf[hdr_len], cur_string, cur_len);
+      hdr_len += cur_len;
+    }
+  }
+
   /* write content-type, ATTENTION: this includes the double-CRLF! */
   cur_string = file_type;
   cur_len = strlen(cur_string);
@@ -2,10 +2,16 @@
 
 if [ ! -f makefsdata ]; then
     # Doing this outside cmake as we don't want it cross-compiled but for host
+    # zlib gzips the files, the browser unpacks them with "Content-Encoding: gzip"
     echo Compiling makefsdata
-    gcc -o build/makefsdata -I../../pico-sdk/lib/lwip/src/include/ -Iinclude -I. makefsdata/makefsdata.c
+    gcc -o build/makefsdata -I../../pico-sdk/lib/lwip/src/include/ -Iinclude -I. \
+        -DMAKEFS_SUPPORT_DEFLATE=1 -DMAKEFS_SUPPORT_DEFLATE_ZLIB=1 makefsdata/makefsdata.c -lz
 fi
 
 echo Regenerating fsdata.c
-./build/makefsdata ./fs -f:include/pico_printer_fs.c
+./build/makefsdata ./fs_pokemon -gzip -etag -f:include/pokemon_storage_fs.c
+# the printer frontend is built from its own checkout, pico_printer_fs.c stays as generated there
+if [ -d ./fs ]; then
+    ./build/makefsdata ./fs -f:include/pico_printer_fs.c
+fi
 echo Done
@@ -0,0 +1,238 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "json_writer.h"
+
+void json_init(json_writer_t * json, char * buffer, size_t size) {
+    json_init_sink(json, buffer, size, NULL, NULL);
+}
+
+void json_init_sink(json_writer_t * json, char * buffer, size_t size, json_sink_t sink, void * arg) {
+    memset(json, 0, sizeof(json_writer_t));
+    json->buffer = buffer;
+    json->size = size;
+    json->sink = sink;
+    json->sink_arg = arg;
+}
+
+static bool json_flush(json_writer_t * json) {
+    if (!json->sink || !json->size) return false;
+    if (!json->sink(json->sink_arg, json->buffer, json->len)) return false;
+    json->len = 0;
+    return true;
+}
+
+static void json_put_slow(json_writer_t * json, const char * data, size_t len) {
+    while (len && !json->overflow) {
+        if ((json->len == json->size) && !json_flush(json)) {
+            json->overflow = true;
+            break;
+        }
+        size_t chunk = json->size - json->len;
+        if (chunk > len) chunk = len;
+        memcpy(json->buffer + json->len, data, chunk);
+        json->len += chunk;
+        data += chunk;
+        len -= chunk;
+    }
+}
+
+static inline void json_put(json_writer_t * json, const char * data, size_t len) {
+    json->total += len;
+    if ((len <= (json->size - json->len)) && !json->overflow) {
+        memcpy(json->buffer + json->len, data, len);
+        json->len += len;
+    } else {
+        json_put_slow(json, data, len);
+    }
+}
+
+static inline void json_putc(json_writer_t * json, char c) {
+    json->total++;
+    if ((json->len < json->size) && !json->overflow) {
+        json->buffer[json->len++] = c;
+    } else {
+        json_put_slow(json, &c, 1);
+    }
+}
+
+// Comma before a value or key unless it is the first at its depth or the value of a key
+static void json_separate(json_writer_t * json) {
+    if (json->key) {
+        json->key = false;
+        return;
+    }
+    uint32_t bit = 1u << json->depth;
+    if (json->items & bit) json_putc(json, ',');
+    json->items |= bit;
+}
+
+static void json_open(json_writer_t * json, char bracket) {
+    json_separate(json);
+    json_putc(json, bracket);
+    if (json->depth < (JSON_MAX_DEPTH - 1)) json->depth++;
+    json->items &= ~(1u << json->depth);
+}
+
+static void json_close(json_writer_t * json, char bracket) {
+    if (json->depth) json->depth--;
+    json_putc(json, bracket);
+}
+
+void json_object_begin(json_writer_t * json) {
+    json_open(json, '{');
+}
+
+void json_object_end(json_writer_t * json) {
+    json_close(json, '}');
+}
+
+void json_array_begin(json_writer_t * json) {
+    json_open(json, '[');
+}
+
+void json_array_end(json_writer_t * json) {
+    json_close(json, ']');
+}
+
+void json_key(json_writer_t * json, const char * key) {
+    json_separate(json);
+    json_putc(json, '"');
+    json_put(json, key, strlen(key));
+    json_put(json, "\":", 2);
+    json->key = true;
+}
+
+static inline bool json_needs_escape(uint8_t c) {
+    return (c < 0x20) || (c == '"') || (c == '\\');
+}
+
+// True when none of the four bytes needs escaping: no control character, quote or backslash.
+// Bytes from 0x80 up pass, UTF-8 is copied as it is.
+static inline bool json_word_clean(const char * p) {
+    uint32_t word;
+    memcpy(&word, p, sizeof(word));     // the M0+ has no unaligned loads
+    uint32_t quote = word ^ 0x22222222u;
+    uint32_t backslash = word ^ 0x5c5c5c5cu;
+    uint32_t found = ((word - 0x20202020u) & ~word) |
+                     ((quote - 0x01010101u) & ~quote) |
+                     ((backslash - 0x01010101u) & ~backslash);
+    return !(found & 0x80808080u);
+}
+
+static size_t json_escape_char(uint8_t c, char * escape) {
+    static const char hex[] = "0123456789abcdef";
+    escape[0] = '\\';
+    switch (c) {
+        case '"':  escape[1] = '"';  return 2;
+        case '\\': escape[1] = '\\'; return 2;
+        case '\n': escape[1] = 'n';  return 2;
+        case '\r': escape[1] = 'r';  return 2;
+        case '\t': escape[1] = 't';  return 2;
+        case '\b': escape[1] = 'b';  return 2;
+        case '\f': escape[1] = 'f';  return 2;
+    }
+    memcpy(&escape[1], "u00", 3);
+    escape[4] = hex[c >> 4];
+    escape[5] = hex[c & 0xf];
+    return 6;
+}
+
+void json_string_append(json_writer_t * json, const char * value, size_t len) {
+    size_t start = 0;
+    size_t i = 0;
+    while (i < len) {
+        while (((len - i) >= 4) && json_word_clean(value + i)) i += 4;
+        // the word holds a byte to escape, or only a tail shorter than a word is left
+        size_t stop = ((len - i) >= 4) ? (i + 4) : len;
+        for (; i < stop; i++) {
+            if (!json_needs_escape(value[i])) continue;
+            char escape[6];
+            json_put(json, value + start, i - start);
+            json_put(json, escape, json_escape_char(value[i], escape));
+            start = i + 1;
+        }
+    }
+    json_put(json, value + start, len - start);
+}
+
+size_t json_escaped_length(const char * value, size_t len) {
+    size_t escaped = len;
+    size_t i = 0;
+    while (i < len) {
+        while (((len - i) >= 4) && json_word_clean(value + i)) i += 4;
+        size_t stop = ((len - i) >= 4) ? (i + 4) : len;
+        for (; i < stop; i++) {
+            if (!json_needs_escape(value[i])) continue;
+            char escape[6];
+            escaped += json_escape_char(value[i], escape) - 1;
+        }
+    }
+    return escaped;
+}
+
+void json_string_begin(json_writer_t * json) {
+    json_separate(json);
+    json_putc(json, '"');
+}
+
+void json_string_end(json_writer_t * json) {
+    json_putc(json, '"');
+}
+
+void json_string_len(json_writer_t * json, const char * value, size_t len) {
+    json_string_begin(json);
+    json_string_append(json, value, len);
+    json_string_end(json);
+}
+
+void json_string(json_writer_t * json, const char * value) {
+    json_string_len(json, value, value ? strlen(value) : 0);
+}
+
+void json_uint(json_writer_t * json, uint32_t value) {
+    char digits[10];
+    size_t pos = sizeof(digits);
+    do {
+        digits[--pos] = '0' + (value % 10);
+        value /= 10;
+    } while (value);
+    json_separate(json);
+    json_put(json, &digits[pos], sizeof(digits) - pos);
+}
+
+void json_int(json_writer_t * json, int32_t value) {
+    if (value >= 0) {
+        json_uint(json, (uint32_t)value);
+        return;
+    }
+    json_separate(json);
+    json_putc(json, '-');
+    json->key = true;                   // the digits follow without a comma
+    json_uint(json, (uint32_t)0 - (uint32_t)value);
+}
+
+void json_bool(json_writer_t * json, bool value) {
+    json_separate(json);
+    if (value) {
+        json_put(json, "true", 4);
+    } else {
+        json_put(json, "false", 5);
+    }
+}
+
+void json_raw(json_writer_t * json, const char * data, size_t len) {
+    json_put(json, data, len);
+}
+
+void json_raw_value(json_writer_t * json, const char * data, size_t len) {
+    json_separate(json);
+    json_put(json, data, len);
+}
+
+size_t json_finish(json_writer_t * json) {
+    if (json->sink && json->len && !json->overflow && !json_flush(json)) json->overflow = true;
+    return json->total;
+}
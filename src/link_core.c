@@ -0,0 +1,193 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#if LINK_CORE_SPLIT
+#include "pico/multicore.h"
+#endif
+
+#include "globals.h"
+#include "linkcable.h"
+#include "link_core.h"
+#include "spsc_queue.h"
+#include "pokemon_trading.h"
+
+// Set by the link interrupt, checked and cleared by the watchdog
+static volatile bool link_cable_data_received = false;
+
+#if LINKCABLE_USE_DMA
+// Consumes everything the RX ring collected, answering each byte
+static void link_core_drain(void) {
+    do {
+        pokemon_trading_update();
+    } while (linkcable_rx_available());
+}
+#endif
+
+static void link_cable_ISR(void) {
+#if LINKCABLE_USE_DMA
+    // a batch boundary, or a byte that needs its answer before the next transfer
+    link_core_drain();
+#else
+    pokemon_trading_update();
+#endif
+    link_cable_data_received = true;
+}
+
+static void link_core_watchdog(void) {
+    // the link interrupt would run the state machine on a half reset session
+    uint32_t status = save_and_disable_interrupts();
+    if (!link_cable_data_received) {
+        linkcable_reset();
+        pokemon_trading_reset();
+    } else {
+        link_cable_data_received = false;
+    }
+    restore_interrupts(status);
+}
+
+static void link_core_service(void) {
+#if LINKCABLE_USE_DMA
+    // whatever the interrupts left, held off meanwhile so the state machine never runs twice at once
+    uint32_t status = save_and_disable_interrupts();
+    if (linkcable_rx_available()) link_cable_data_received = true;
+    link_core_drain();
+    restore_interrupts(status);
+#else
+    pokemon_trading_update();
+#endif
+}
+
+#if LINK_CORE_SPLIT
+
+typedef enum {
+    LINK_CORE_CMD_RESET,
+    LINK_CORE_CMD_SEND
+} link_core_cmd_t;
+
+typedef struct {
+    link_core_cmd_t cmd;
+    size_t index;
+} link_core_command_t;
+
+typedef struct {
+    pokemon_data_t pokemon;
+    const char * source_game;
+} link_core_commit_t;
+
+// core 0 -> core 1
+SPSC_QUEUE_DEFINE(command_queue, link_core_command_t, 8);
+// core 1 -> core 0
+SPSC_QUEUE_DEFINE(commit_queue, link_core_commit_t, 4);
+
+static bool link_core_push_command(link_core_cmd_t cmd, size_t index) {
+    link_core_command_t command = { cmd, index };
+    // the main loop and the key interrupt both produce on core 0, keep them from interleaving
+    uint32_t status = save_and_disable_interrupts();
+    bool queued = spsc_queue_push(&command_queue, &command);
+    restore_interrupts(status);
+    return queued;
+}
+
+static void link_core_entry(void) {
+    // the PIO and DMA interrupts are enabled on the core that calls linkcable_init()
+    linkcable_init(link_cable_ISR);
+
+    // the default alarm pool fires on core 0, so the watchdog is polled here
+    uint64_t watchdog = time_us_64();
+    while (true) {
+        link_core_command_t command;
+        while (spsc_queue_pop(&command_queue, &command)) {
+            // the link interrupt is held off, as in link_core_service(), so it never sees a
+            // half reset session or a half queued trade block
+            uint32_t status = save_and_disable_interrupts();
+            switch (command.cmd) {
+                case LINK_CORE_CMD_RESET:
+                    linkcable_reset();
+                    pokemon_trading_reset();
+                    break;
+                case LINK_CORE_CMD_SEND:
+                    pokemon_send_stored(command.index);
+                    break;
+            }
+            restore_interrupts(status);
+        }
+        link_core_service();
+        if ((time_us_64() - watchdog) >= LINK_CORE_WATCHDOG_US) {
+            watchdog = time_us_64();
+            link_core_watchdog();
+        }
+    }
+}
+
+void link_core_launch(void) {
+    multicore_launch_core1(link_core_entry);
+}
+
+void link_core_process(void) {
+    link_core_commit_t commit;
+    while (spsc_queue_pop(&commit_queue, &commit)) {
+        if (!pokemon_commit_trade(&commit.pokemon, commit.source_game)) {
+            pokemon_log_trade_event("ERROR", "Traded Pokemon could not be stored");
+        }
+    }
+}
+
+void link_core_request_reset(void) {
+    link_core_push_command(LINK_CORE_CMD_RESET, 0);
+}
+
+bool link_core_request_send(size_t index) {
+    return link_core_push_command(LINK_CORE_CMD_SEND, index);
+}
+
+bool link_core_commit_trade(const pokemon_data_t * pokemon, const char * source_game) {
+    // the answer to the Game Boy can not wait for core 0, so the free space is checked here,
+    // counting the commits core 0 has not picked up yet
+    if ((pokemon_get_stored_count() + spsc_queue_count(&commit_queue)) >= MAX_STORED_POKEMON) return false;
+
+    link_core_commit_t commit = { .pokemon = *pokemon, .source_game = source_game };
+    return spsc_queue_push(&commit_queue, &commit);
+}
+
+#else
+
+static int64_t link_cable_watchdog(alarm_id_t id, void *user_data) {
+    (void)id;
+    (void)user_data;
+    link_core_watchdog();
+    return LINK_CORE_WATCHDOG_US;
+}
+
+void link_core_launch(void) {
+    linkcable_init(link_cable_ISR);
+    add_alarm_in_us(LINK_CORE_WATCHDOG_US, link_cable_watchdog, NULL, true);
+}
+
+void link_core_process(void) {
+    link_core_service();
+}
+
+void link_core_request_reset(void) {
+    // the link interrupt runs on this core too
+    uint32_t status = save_and_disable_interrupts();
+    linkcable_reset();
+    pokemon_trading_reset();
+    restore_interrupts(status);
+}
+
+bool link_core_request_send(size_t index) {
+    uint32_t status = save_and_disable_interrupts();
+    bool sent = pokemon_send_stored(index);
+    restore_interrupts(status);
+    return sent;
+}
+
+bool link_core_commit_trade(const pokemon_data_t * pokemon, const char * source_game) {
+    return pokemon_commit_trade(pokemon, source_game);
+}
+
+#endif
@@ -0,0 +1,118 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "hardware/timer.h"
+#include "hardware/pio.h"
+
+#include "linkcable.h"
+#include "link_latency.h"
+#include "json_writer.h"
+
+static link_latency_hist_t link_latency[LINK_LATENCY_STATES];
+
+static volatile uint32_t rx_stamp = 0;
+static volatile bool rx_pending = false;
+
+static inline uint32_t link_latency_bucket(uint32_t us) {
+    if (!us) return 0;
+    uint32_t bucket = 32 - __builtin_clz(us);
+    return (bucket < LINK_LATENCY_BUCKETS) ? bucket : (LINK_LATENCY_BUCKETS - 1);
+}
+
+void link_latency_rx(void) {
+    rx_stamp = time_us_32();
+    rx_pending = true;
+}
+
+void link_latency_tx(trade_state_t state) {
+    // answers that were not triggered by a received byte (block sends from the web UI) are not counted
+    if (!rx_pending) return;
+    rx_pending = false;
+    if ((uint32_t)state >= LINK_LATENCY_STATES) return;
+
+    uint32_t delta = time_us_32() - rx_stamp;
+    link_latency_hist_t *hist = &link_latency[state];
+    hist->samples++;
+    if (delta > hist->worst_us) hist->worst_us = delta;
+    hist->buckets[link_latency_bucket(delta)]++;
+
+#if LINKCABLE_USE_DMA
+    if (linkcable_rx_available()) hist->late++;
+    if (linkcable_tx_free() < LINKCABLE_DMA_RING_SIZE || !pio_sm_is_tx_fifo_empty(LINKCABLE_PIO, LINKCABLE_SM)) hist->backlog++;
+#else
+    if (!pio_sm_is_rx_fifo_empty(LINKCABLE_PIO, LINKCABLE_SM)) hist->late++;
+    if (!pio_sm_is_tx_fifo_empty(LINKCABLE_PIO, LINKCABLE_SM)) hist->backlog++;
+#endif
+}
+
+void link_latency_preloaded(trade_state_t state) {
+    rx_pending = false;
+    if ((uint32_t)state < LINK_LATENCY_STATES) link_latency[state].preloaded++;
+}
+
+void link_latency_reset(void) {
+    rx_pending = false;
+    memset(link_latency, 0, sizeof(link_latency));
+}
+
+const link_latency_hist_t * link_latency_get(trade_state_t state) {
+    return ((uint32_t)state < LINK_LATENCY_STATES) ? &link_latency[state] : NULL;
+}
+
+void link_latency_write_json(json_writer_t * json) {
+    json_object_begin(json);
+    json_key(json, "bucket_us");
+    json_array_begin(json);
+    json_uint(json, 0);
+    for (uint32_t i = 1; i < LINK_LATENCY_BUCKETS; i++) {
+        json_uint(json, 1ul << (i - 1));
+    }
+    json_array_end(json);
+    json_key(json, "rx_overruns");
+    json_uint(json, linkcable_get_rx_overruns());
+    json_key(json, "states");
+    json_array_begin(json);
+
+    for (uint32_t state = 0; state < LINK_LATENCY_STATES; state++) {
+        const link_latency_hist_t *hist = &link_latency[state];
+        if (!hist->samples && !hist->preloaded) continue;
+        json_object_begin(json);
+        json_key(json, "state");
+        json_string(json, trade_state_to_string((trade_state_t)state));
+        json_key(json, "samples");
+        json_uint(json, hist->samples);
+        json_key(json, "worst_us");
+        json_uint(json, hist->worst_us);
+        json_key(json, "late");
+        json_uint(json, hist->late);
+        json_key(json, "backlog");
+        json_uint(json, hist->backlog);
+        json_key(json, "preloaded");
+        json_uint(json, hist->preloaded);
+        json_key(json, "buckets");
+        json_array_begin(json);
+        for (uint32_t i = 0; i < LINK_LATENCY_BUCKETS; i++) {
+            json_uint(json, hist->buckets[i]);
+        }
+        json_array_end(json);
+        json_object_end(json);
+    }
+    json_array_end(json);
+    json_object_end(json);
+}
+
+size_t link_latency_render_json(char * buffer, size_t size) {
+    json_writer_t json;
+    json_init(&json, buffer, size);
+    link_latency_write_json(&json);
+
+    if (json_overflowed(&json)) {
+        // an empty object is still valid JSON for the reader
+        json_init(&json, buffer, size);
+        json_object_begin(&json);
+        json_object_end(&json);
+    }
+    return json_length(&json);
+}
@@ -5,25 +5,204 @@
 
 #include "hardware/pio.h"
 #include "hardware/irq.h"
+#include "hardware/sync.h"
+#if LINKCABLE_USE_DMA
+#include "hardware/dma.h"
+#endif
 
 #include "linkcable.h"
+#include "link_latency.h"
 
 #include "linkcable.pio.h"
 
 static irq_handler_t linkcable_irq_handler = NULL;
 static uint32_t linkcable_pio_initial_pc = 0;
 
+#if LINKCABLE_USE_DMA
+
+#define LINKCABLE_DMA_RING_MASK (LINKCABLE_DMA_RING_SIZE - 1)
+
+// DMA ring wrapping requires the rings to be aligned to their size
+static uint8_t linkcable_rx_ring[LINKCABLE_DMA_RING_SIZE] __attribute__((aligned(LINKCABLE_DMA_RING_SIZE)));
+static uint8_t linkcable_tx_ring[LINKCABLE_DMA_RING_SIZE] __attribute__((aligned(LINKCABLE_DMA_RING_SIZE)));
+
+static int linkcable_rx_dma = -1;
+static int linkcable_tx_dma = -1;
+
+// All counters are free running, ring positions are taken modulo the ring size
+static volatile uint32_t rx_batches = 0;        // completed RX batches
+static uint32_t rx_consumed = 0;                // bytes handed out by linkcable_rx_pop()
+static uint32_t rx_overruns = 0;                // bytes overwritten before they were read
+static volatile uint32_t tx_head = 0;           // bytes queued into the TX ring
+static volatile uint32_t tx_dispatched = 0;     // bytes handed over to the TX DMA channel
+
+static inline uint32_t linkcable_rx_produced(void) {
+    // bytes of the running batch are the ones the channel has already transferred
+    uint32_t batches, remaining;
+    do {
+        batches = rx_batches;
+        remaining = dma_channel_hw_addr(linkcable_rx_dma)->transfer_count;
+    } while (batches != rx_batches);
+    return (batches * LINKCABLE_DMA_BATCH) + (LINKCABLE_DMA_BATCH - remaining);
+}
+
+static void linkcable_rx_dma_start(void) {
+    dma_channel_config c = dma_channel_get_default_config(linkcable_rx_dma);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, LINKCABLE_DMA_RING_BITS);
+    channel_config_set_dreq(&c, pio_get_dreq(LINKCABLE_PIO, LINKCABLE_SM, false));
+    rx_batches = 0;
+    rx_consumed = 0;
+    dma_channel_configure(linkcable_rx_dma, &c, linkcable_rx_ring, &LINKCABLE_PIO->rxf[LINKCABLE_SM], LINKCABLE_DMA_BATCH, true);
+}
+
+// The answer to a byte goes out with the next transfer, so a byte whose answer is not queued
+// yet needs its PIO interrupt, the batch interrupt comes too late. While the TX channel still
+// waits for FIFO room, answers for the next transfers are queued and that interrupt is masked;
+// the channel's completion interrupt unmasks it before the FIFO runs dry.
+static bool linkcable_byte_irq_enabled = false;
+
+static void linkcable_byte_irq_update(void) {
+    bool enable = !dma_channel_is_busy(linkcable_tx_dma);
+    if (enable == linkcable_byte_irq_enabled) return;
+    // the flag of a byte shifted in while masked is stale, that byte's answer was queued
+    if (enable) pio_interrupt_clear(LINKCABLE_PIO, 0);
+    pio_set_irq0_source_enabled(LINKCABLE_PIO, pis_interrupt0, enable);
+    linkcable_byte_irq_enabled = enable;
+}
+
+// Hands everything queued since the last dispatch to the TX channel, if it is idle.
+// Must be called with interrupts disabled, it runs both from thread context and from the DMA IRQ.
+static void linkcable_tx_dma_kick(void) {
+    uint32_t pending = tx_head - tx_dispatched;
+    if (pending && !dma_channel_is_busy(linkcable_tx_dma)) {
+        // the channel wraps its read address inside the ring, so one transfer covers a wrapped span
+        dma_channel_set_read_addr(linkcable_tx_dma, &linkcable_tx_ring[tx_dispatched & LINKCABLE_DMA_RING_MASK], false);
+        dma_channel_set_trans_count(linkcable_tx_dma, pending, true);
+        tx_dispatched = tx_head;
+    }
+    linkcable_byte_irq_update();
+}
+
+static void linkcable_tx_dma_setup(void) {
+    dma_channel_config c = dma_channel_get_default_config(linkcable_tx_dma);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_ring(&c, false, LINKCABLE_DMA_RING_BITS);
+    channel_config_set_dreq(&c, pio_get_dreq(LINKCABLE_PIO, LINKCABLE_SM, true));
+    tx_head = tx_dispatched = 0;
+    dma_channel_configure(linkcable_tx_dma, &c, &LINKCABLE_PIO->txf[LINKCABLE_SM], linkcable_tx_ring, 0, false);
+    linkcable_byte_irq_update();
+}
+
+static void linkcable_dma_isr(void) {
+    if (dma_channel_get_irq0_status(linkcable_rx_dma)) {
+        dma_channel_acknowledge_irq0(linkcable_rx_dma);
+        // re-arm first: the write address carries on around the ring, the PIO FIFO covers the gap
+        rx_batches++;
+        dma_channel_set_trans_count(linkcable_rx_dma, LINKCABLE_DMA_BATCH, true);
+        if (linkcable_irq_handler) linkcable_irq_handler();
+    }
+    if (dma_channel_get_irq0_status(linkcable_tx_dma)) {
+        dma_channel_acknowledge_irq0(linkcable_tx_dma);
+        linkcable_tx_dma_kick();
+    }
+}
+
+static void linkcable_byte_isr(void) {
+    link_latency_rx();
+    pio_interrupt_clear(LINKCABLE_PIO, 0);
+    if (linkcable_irq_handler) linkcable_irq_handler();
+}
+
+size_t linkcable_rx_available(void) {
+    uint32_t produced = linkcable_rx_produced();
+    if (produced - rx_consumed > LINKCABLE_DMA_RING_SIZE) {
+        // the reader fell a whole ring behind, skip to the oldest byte still intact
+        rx_overruns += (produced - rx_consumed) - LINKCABLE_DMA_RING_SIZE;
+        rx_consumed = produced - LINKCABLE_DMA_RING_SIZE;
+    }
+    return produced - rx_consumed;
+}
+
+bool linkcable_rx_pop(uint8_t * data) {
+    if (!linkcable_rx_available()) return false;
+    *data = linkcable_rx_ring[rx_consumed++ & LINKCABLE_DMA_RING_MASK];
+    return true;
+}
+
+size_t linkcable_tx_free(void) {
+    uint32_t status = save_and_disable_interrupts();
+    uint32_t in_flight = dma_channel_is_busy(linkcable_tx_dma) ? dma_channel_hw_addr(linkcable_tx_dma)->transfer_count : 0;
+    uint32_t queued = (tx_head - tx_dispatched) + in_flight;
+    restore_interrupts(status);
+    return LINKCABLE_DMA_RING_SIZE - queued;
+}
+
+size_t linkcable_tx_write(const uint8_t * data, size_t length) {
+    size_t free_space = linkcable_tx_free();
+    if (length > free_space) length = free_space;
+    uint32_t head = tx_head;
+    for (size_t i = 0; i < length; i++) {
+        linkcable_tx_ring[(head + i) & LINKCABLE_DMA_RING_MASK] = data[i];
+    }
+    uint32_t status = save_and_disable_interrupts();
+    tx_head = head + length;
+    linkcable_tx_dma_kick();
+    restore_interrupts(status);
+    return length;
+}
+
+void linkcable_tx_flush(void) {
+    // drops everything queued that the state machine has not shifted out yet
+    uint32_t status = save_and_disable_interrupts();
+    dma_channel_abort(linkcable_tx_dma);
+    dma_channel_acknowledge_irq0(linkcable_tx_dma);
+    tx_dispatched = tx_head;
+    pio_sm_clear_fifos(LINKCABLE_PIO, LINKCABLE_SM);
+    linkcable_byte_irq_update();
+    restore_interrupts(status);
+}
+
+uint32_t linkcable_get_rx_overruns(void) {
+    return rx_overruns;
+}
+
+#else
+
 static void linkcable_isr(void) {
+    link_latency_rx();
     if (linkcable_irq_handler) linkcable_irq_handler();
     if (pio_interrupt_get(LINKCABLE_PIO, 0)) pio_interrupt_clear(LINKCABLE_PIO, 0);
 }
 
+uint32_t linkcable_get_rx_overruns(void) {
+    return 0;
+}
+
+#endif
+
 void linkcable_reset(void) {
     pio_sm_set_enabled(LINKCABLE_PIO, LINKCABLE_SM, false);
+#if LINKCABLE_USE_DMA
+    uint32_t status = save_and_disable_interrupts();
+    dma_channel_abort(linkcable_rx_dma);
+    dma_channel_abort(linkcable_tx_dma);
+    dma_channel_acknowledge_irq0(linkcable_rx_dma);
+    dma_channel_acknowledge_irq0(linkcable_tx_dma);
+    restore_interrupts(status);
+#endif
     pio_sm_clear_fifos(LINKCABLE_PIO, LINKCABLE_SM);
     pio_sm_restart(LINKCABLE_PIO, LINKCABLE_SM);
     pio_sm_clkdiv_restart(LINKCABLE_PIO, LINKCABLE_SM);
     pio_sm_exec(LINKCABLE_PIO, LINKCABLE_SM, pio_encode_jmp(linkcable_pio_initial_pc));
+#if LINKCABLE_USE_DMA
+    linkcable_rx_dma_start();
+    linkcable_tx_dma_setup();
+#endif
     pio_sm_set_enabled(LINKCABLE_PIO, LINKCABLE_SM, true);
 }
 
@@ -32,6 +211,23 @@ void linkcable_init(irq_handler_t onDataReceive) {
 
     // Put initial value in TX FIFO so PIO can respond
     pio_sm_put_blocking(LINKCABLE_PIO, LINKCABLE_SM, 0x00);
+
+#if LINKCABLE_USE_DMA
+    // In DMA mode onDataReceive is called once per LINKCABLE_DMA_BATCH received bytes and for
+    // every byte whose answer is not queued ahead, it reads the bytes with linkcable_receive()
+    linkcable_irq_handler = onDataReceive;
+    linkcable_rx_dma = dma_claim_unused_channel(true);
+    linkcable_tx_dma = dma_claim_unused_channel(true);
+    linkcable_rx_dma_start();
+    linkcable_tx_dma_setup();
+    dma_channel_set_irq0_enabled(linkcable_rx_dma, true);
+    dma_channel_set_irq0_enabled(linkcable_tx_dma, true);
+    irq_set_exclusive_handler(DMA_IRQ_0, linkcable_dma_isr);
+    irq_set_enabled(DMA_IRQ_0, true);
+    irq_set_exclusive_handler(PIO0_IRQ_0, linkcable_byte_isr);
+    irq_set_enabled(PIO0_IRQ_0, true);
+    pio_enable_sm_mask_in_sync(LINKCABLE_PIO, (1u << LINKCABLE_SM));
+#else
     pio_enable_sm_mask_in_sync(LINKCABLE_PIO, (1u << LINKCABLE_SM));
 
     if (onDataReceive) {
@@ -40,9 +236,18 @@ void linkcable_init(irq_handler_t onDataReceive) {
         irq_set_exclusive_handler(PIO0_IRQ_0, linkcable_isr);
         irq_set_enabled(PIO0_IRQ_0, true);
     }
+#endif
 }
 
 void linkcable_send_data(const uint8_t* data, size_t length) {
+#if LINKCABLE_USE_DMA
+    // Queue through the TX ring, waiting only when it is full
+    while (length) {
+        size_t written = linkcable_tx_write(data, length);
+        data += written;
+        length -= written;
+    }
+#else
     for (size_t i = 0; i < length; ++i) {
         // The existing linkcable_send is static inline in the .h file.
         // We need to use the PIO function directly here or make linkcable_send non-inline.
@@ -51,6 +256,7 @@ void linkcable_send_data(const uint8_t* data, size_t length) {
         // TODO: Add a small delay or check PIO state if needed, 
         // especially if the other side is slow or for protocol timing.
     }
+#endif
 }
 
 void linkcable_send_trade_block(const trade_block_t* trade_block) {
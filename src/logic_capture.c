@@ -0,0 +1,157 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/clocks.h"
+
+#include "logic_capture.h"
+#include "json_writer.h"
+
+#include "linkcable.pio.h"
+#include "logic_capture.pio.h"
+
+// The four sampled pins start at the lowest link cable pin
+#define LOGIC_CAPTURE_MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define LOGIC_CAPTURE_BASE      LOGIC_CAPTURE_MIN(PIN_SCK, LOGIC_CAPTURE_MIN(PIN_SIN, PIN_SOUT))
+_Static_assert((PIN_SCK - LOGIC_CAPTURE_BASE < 4) && (PIN_SIN - LOGIC_CAPTURE_BASE < 4) &&
+               (PIN_SOUT - LOGIC_CAPTURE_BASE < 4), "link cable pins must be within 4 GPIOs");
+
+// The sampled pin bits of one nibble, in every nibble of a word
+#define LOGIC_CAPTURE_NIBBLE    ((1u << (PIN_SCK - LOGIC_CAPTURE_BASE)) | (1u << (PIN_SIN - LOGIC_CAPTURE_BASE)) | \
+                                 (1u << (PIN_SOUT - LOGIC_CAPTURE_BASE)))
+#define LOGIC_CAPTURE_MASK      (LOGIC_CAPTURE_NIBBLE * 0x11111111u)
+
+static uint32_t logic_capture_buffer[LOGIC_CAPTURE_WORDS];
+
+static int logic_capture_sm = -1;
+static int logic_capture_dma = -1;
+static uint logic_capture_offset = 0;
+
+static uint32_t logic_capture_rate = 0;
+static bool logic_capture_armed = false;        // started and not stopped yet
+static bool logic_capture_triggered = false;    // valid once stopped
+static uint32_t logic_capture_words = 0;        // valid once stopped
+
+// The state machine and channel are claimed with the first capture and kept
+static bool logic_capture_claim(void) {
+    if (logic_capture_sm >= 0) return true;
+    if (!pio_can_add_program(LOGIC_CAPTURE_PIO, &logic_capture_program)) return false;
+    int sm = pio_claim_unused_sm(LOGIC_CAPTURE_PIO, false);
+    if (sm < 0) return false;
+    int dma = dma_claim_unused_channel(false);
+    if (dma < 0) {
+        pio_sm_unclaim(LOGIC_CAPTURE_PIO, sm);
+        return false;
+    }
+    logic_capture_offset = pio_add_program(LOGIC_CAPTURE_PIO, &logic_capture_program);
+    logic_capture_sm = sm;
+    logic_capture_dma = dma;
+    return true;
+}
+
+bool logic_capture_start(uint32_t rate) {
+    if (!logic_capture_claim()) return false;
+    logic_capture_stop();
+
+    // the divider is 1 to 65536
+    uint32_t sys_hz = clock_get_hz(clk_sys);
+    if ((rate == 0) || (rate > sys_hz)) rate = sys_hz;
+    if (rate < (sys_hz >> 16) + 1) rate = (sys_hz >> 16) + 1;
+    logic_capture_rate = rate;
+
+    logic_capture_program_init(LOGIC_CAPTURE_PIO, logic_capture_sm, logic_capture_offset,
+                               LOGIC_CAPTURE_BASE, PIN_SCK, (float)sys_hz / rate);
+
+    dma_channel_config c = dma_channel_get_default_config(logic_capture_dma);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_dreq(&c, pio_get_dreq(LOGIC_CAPTURE_PIO, logic_capture_sm, false));
+    dma_channel_configure(logic_capture_dma, &c, logic_capture_buffer, &LOGIC_CAPTURE_PIO->rxf[logic_capture_sm],
+                          LOGIC_CAPTURE_WORDS, true);
+
+    logic_capture_armed = true;
+    pio_sm_set_enabled(LOGIC_CAPTURE_PIO, logic_capture_sm, true);
+    return true;
+}
+
+void logic_capture_stop(void) {
+    if (!logic_capture_armed) return;
+    // past the trigger the program only loops over its one IN instruction
+    uint pc = pio_sm_get_pc(LOGIC_CAPTURE_PIO, logic_capture_sm);
+    pio_sm_set_enabled(LOGIC_CAPTURE_PIO, logic_capture_sm, false);
+    dma_channel_abort(logic_capture_dma);
+    logic_capture_words = LOGIC_CAPTURE_WORDS - dma_channel_hw_addr(logic_capture_dma)->transfer_count;
+    logic_capture_triggered = (logic_capture_words != 0) ||
+                              (pc == logic_capture_offset + logic_capture_wrap_target);
+    logic_capture_armed = false;
+}
+
+bool logic_capture_running(void) {
+    return logic_capture_armed && dma_channel_is_busy(logic_capture_dma);
+}
+
+// Sample nibble to LOGIC_CAPTURE_* bits
+static inline uint32_t logic_capture_state(uint32_t nibble) {
+    return (((nibble >> (PIN_SCK - LOGIC_CAPTURE_BASE)) & 1) ? LOGIC_CAPTURE_SCK : 0) |
+           (((nibble >> (PIN_SIN - LOGIC_CAPTURE_BASE)) & 1) ? LOGIC_CAPTURE_SIN : 0) |
+           (((nibble >> (PIN_SOUT - LOGIC_CAPTURE_BASE)) & 1) ? LOGIC_CAPTURE_SOUT : 0);
+}
+
+size_t logic_capture_render_json(char * buffer, size_t size) {
+    logic_capture_stop();
+    uint32_t samples = logic_capture_words * 8;
+
+    json_writer_t json;
+    json_init(&json, buffer, size);
+    json_object_begin(&json);
+    json_key(&json, "rate");
+    json_uint(&json, logic_capture_rate);
+    json_key(&json, "triggered");
+    json_bool(&json, logic_capture_triggered);
+    json_key(&json, "samples");
+    json_uint(&json, samples);
+    json_key(&json, "levels");
+    json_uint(&json, logic_capture_state((gpio_get_all() >> LOGIC_CAPTURE_BASE) & 0xF));
+    json_key(&json, "runs");
+    json_array_begin(&json);
+
+    // a run ends where a sampled pin changes, whole words without a change are skipped at once
+    bool truncated = false;
+    uint32_t run_state = logic_capture_state(logic_capture_buffer[0] & 0xF);
+    uint32_t run_start = 0;
+    uint32_t sample = 0;
+    for (uint32_t i = 0; (i < logic_capture_words) && !truncated; i++) {
+        uint32_t word = logic_capture_buffer[i];
+        if (!((word ^ ((word & 0xF) * 0x11111111u)) & LOGIC_CAPTURE_MASK) &&
+            (logic_capture_state(word & 0xF) == run_state)) {
+            sample += 8;
+            continue;
+        }
+        for (uint32_t n = 0; n < 8; n++, sample++, word >>= 4) {
+            uint32_t state = logic_capture_state(word & 0xF);
+            if (state == run_state) continue;
+            if (json_space(&json) < 48) {
+                truncated = true;
+                break;
+            }
+            json_uint(&json, run_state);
+            json_uint(&json, sample - run_start);
+            run_state = state;
+            run_start = sample;
+        }
+    }
+    if (samples && !truncated) {
+        json_uint(&json, run_state);
+        json_uint(&json, sample - run_start);
+    }
+
+    json_array_end(&json);
+    json_key(&json, "truncated");
+    json_bool(&json, truncated);
+    json_object_end(&json);
+    return json_length(&json);
+}
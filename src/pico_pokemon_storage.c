@@ -4,6 +4,7 @@
 #include <time.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include "pico/bootrom.h"
 #include "hardware/timer.h"
 #include "hardware/clocks.h"
@@ -19,39 +20,25 @@
 #include "pokemon_trading.h"
 #include "pokemon_data.h"
 #include "linkcable.h"
+#include "link_latency.h"
+#include "link_core.h"
+#include "trade_log.h"
 #include "websocket_server.h"
+#include "json_writer.h"
+#include "logic_capture.h"
 
 bool debug_enable = ENABLE_DEBUG;
 bool speed_240_MHz = false;
 
-uint8_t file_buffer[FILE_BUFFER_SIZE];              // buffer for rendering JSON responses
 
 // Pokemon trading status
 uint32_t last_trade_time = 0;
 uint32_t total_trades = 0;
 
-// Link cable interrupt handler for Pokemon trading
-bool link_cable_data_received = false;
-void link_cable_ISR(void) {
-    pokemon_trading_update();
-    link_cable_data_received = true;
-}
-
-int64_t link_cable_watchdog(alarm_id_t id, void *user_data) {
-    if (!link_cable_data_received) {
-        linkcable_reset();
-        pokemon_trading_reset();
-    } else {
-        link_cable_data_received = false;
-    }
-    return MS(300);
-}
-
 // Key button for reset
 #ifdef PIN_KEY
 static void key_callback(uint gpio, uint32_t events) {
-    linkcable_reset();
-    pokemon_trading_reset();
+    link_core_request_reset();
     LED_OFF;
 }
 #endif
@@ -61,599 +48,1275 @@ static void key_callback(uint gpio, uint32_t events) {
 #define STATUS_FILE   "/status.json"
 #define POKEMON_FILE  "/pokemon.json"
 #define LOGS_FILE     "/logs.json"
+#define LOGS_TAIL_FILE "/logs_tail.json"
 #define TRADE_FILE    "/trade.json"
+#define LINK_STATS_FILE "/link_stats.json"
+#define DIAGNOSTICS_FILE "/diagnostics.json"
+#define GPIO_MONITOR_FILE "/gpio_monitor.json"
+#define EVENTS_FILE   "/events.json"
+#define BENCH_FILE    "/bench.json"
+
+#define HTTP_ETAG_SIZE  16              // resource letter and generation in hex
+
+// Link latency statistics are pushed to WebSocket clients this often
+#define LINK_STATS_BROADCAST_INTERVAL   MS(1000)
+
+// Query parameters, parsed into an http_query_t by the CGI dispatcher
+typedef enum {
+    HTTP_PARAM_ETAG,                    // conditional request
+    HTTP_PARAM_SINCE,                   // trade log sequence number to continue from
+    HTTP_PARAM_STORE,                   // generations an /events.json client has seen
+    HTTP_PARAM_STATE,
+    HTTP_PARAM_LOG,
+    HTTP_PARAM_INDEX,                   // storage slot
+    HTTP_PARAM_DEBUG,
+    HTTP_PARAM_RESET,
+    HTTP_PARAM_RATE,                    // /gpio_monitor.json samples per second
+    HTTP_PARAM_BYTES,                   // /bench/download length
+    HTTP_PARAM_COUNT
+} http_param_id_t;
 
-// Simple HTML for Pokemon interface
-static const char pokemon_html[] = 
-"<!DOCTYPE html>"
-"<html><head>"
-"<title>Pokemon Storage System</title>"
-"<meta charset='utf-8'>"
-"<meta name='viewport' content='width=device-width, initial-scale=1'>"
-"<style>"
-"body { font-family: Arial, sans-serif; margin: 20px; background: #f0f8ff; }"
-"h1 { color: #1e40af; text-align: center; }"
-".status { background: #e0f2fe; padding: 15px; border-radius: 8px; margin: 10px 0; }"
-".pokemon-card { background: #fff; border: 2px solid #fbbf24; border-radius: 10px; padding: 15px; margin: 10px; display: inline-block; min-width: 200px; }"
-".pokemon-name { font-weight: bold; color: #dc2626; font-size: 18px; }"
-".pokemon-info { margin: 5px 0; color: #374151; }"
-".logs { background: #f3f4f6; padding: 10px; border-radius: 5px; max-height: 200px; overflow-y: auto; font-family: monospace; font-size: 12px; }"
-"button { background: #3b82f6; color: white; border: none; padding: 8px 16px; border-radius: 5px; cursor: pointer; margin: 5px; }"
-"button:hover { background: #2563eb; }"
-".refresh { text-align: center; margin: 20px; }"
-"</style>"
-"</head><body>"
-"<h1>🎮 Pokemon Storage System 🎮</h1>"
-"<div class='status' id='status'>Loading status...</div>"
-"<div class='refresh'><button onclick='loadData()'>Refresh Data</button></div>"
-"<h2>Stored Pokemon</h2>"
-"<div id='pokemon-list'>Loading Pokemon...</div>"
-"<h2>Trading Logs</h2>"
-"<div class='logs' id='logs'>Loading logs...</div>"
-"<script>"
-"function loadData() {"
-"  fetch('/status.json').then(r=>r.json()).then(data => {"
-"    document.getElementById('status').innerHTML = "
-"      `<strong>Status:</strong> ${data.status.trade_state}<br>`+"
-"      `<strong>Stored Pokemon:</strong> ${data.status.stored_pokemon}/256<br>`+"
-"      `<strong>Total Trades:</strong> ${data.status.total_trades}`;"
-"  });"
-"  fetch('/pokemon.json').then(r=>r.json()).then(data => {"
-"    let html = '';"
-"    data.pokemon.forEach(p => {"
-"      html += `<div class='pokemon-card'>`+"
-"        `<div class='pokemon-name'>${p.species}</div>`+"
-"        `<div class='pokemon-info'>Level: ${p.level}</div>`+"
-"        `<div class='pokemon-info'>Type: ${p.type1}/${p.type2}</div>`+"
-"        `<div class='pokemon-info'>Trainer: ${p.trainer}</div>`+"
-"        `<div class='pokemon-info'>Game: ${p.game}</div>`+"
-"        `</div>`;"
-"    });"
-"    document.getElementById('pokemon-list').innerHTML = html || 'No Pokemon stored yet.';"
-"  });"
-"  fetch('/logs.json').then(r=>r.json()).then(data => {"
-"    document.getElementById('logs').innerHTML = data.logs || 'No logs available.';"
-"  });"
-"}"
-"loadData();"
-"setInterval(loadData, 5000);"
-"</script>"
-"</body></html>";
-
-// Real-time test HTML
-static const char realtime_test_html[] = 
-"<!DOCTYPE html>"
-"<html><head>"
-"<title>Pokemon Trading Protocol - Real-time Monitor</title>"
-"<meta charset='utf-8'>"
-"<meta name='viewport' content='width=device-width, initial-scale=1'>"
-"<style>"
-"body{font-family:'Courier New',monospace;background:#1a1a1a;color:#00ff00;margin:0;padding:20px}"
-".container{max-width:1200px;margin:0 auto}"
-"h1{text-align:center;color:#00ffff;text-shadow:0 0 10px #00ffff}"
-".status{background:#2a2a2a;border:2px solid #00ff00;border-radius:10px;padding:15px;margin-bottom:20px;text-align:center}"
-".status.connected{border-color:#00ff00;box-shadow:0 0 20px rgba(0,255,0,0.3)}"
-".status.disconnected{border-color:#ff0000;color:#ff0000;box-shadow:0 0 20px rgba(255,0,0,0.3)}"
-".log-container{background:#000;border:2px solid #333;border-radius:10px;height:400px;overflow-y:auto;padding:15px;font-size:14px;line-height:1.4}"
-".log-entry{margin-bottom:5px;padding:3px 0}"
-".log-entry.protocol{color:#00ffff;font-weight:bold}"
-".log-entry.trade{color:#ffff00}"
-".log-entry.error{color:#ff0000;background:rgba(255,0,0,0.1);padding:5px;border-left:3px solid #ff0000}"
-".log-entry.system{color:#ff00ff}"
-".controls{margin-bottom:20px;text-align:center}"
-".btn{background:#333;color:#00ff00;border:2px solid #00ff00;padding:10px 20px;margin:0 10px;cursor:pointer;border-radius:5px;font-family:inherit}"
-".btn:hover{background:#00ff00;color:#000}"
-".stats{display:grid;grid-template-columns:repeat(auto-fit,minmax(200px,1fr));gap:15px;margin-bottom:20px}"
-".stat-card{background:#2a2a2a;border:1px solid #555;border-radius:8px;padding:15px;text-align:center}"
-".stat-value{font-size:24px;font-weight:bold;color:#00ffff}"
-".stat-label{color:#aaa;font-size:12px;margin-top:5px}"
-"</style>"
-"</head><body>"
-"<div class='container'>"
-"<h1>🎮 Pokemon Trading Protocol Monitor 🎮</h1>"
-"<div class='status' id='connectionStatus'>Connecting to WebSocket...</div>"
-"<div class='stats'>"
-"<div class='stat-card'><div class='stat-value' id='protocolCount'>0</div><div class='stat-label'>Protocol Messages</div></div>"
-"<div class='stat-card'><div class='stat-value' id='tradeCount'>0</div><div class='stat-label'>Trade Events</div></div>"
-"<div class='stat-card'><div class='stat-value' id='errorCount'>0</div><div class='stat-label'>Errors</div></div>"
-"<div class='stat-card'><div class='stat-value' id='connectionTime'>--</div><div class='stat-label'>Connected Time</div></div>"
-"</div>"
-"<div class='controls'>"
-"<button class='btn' onclick='clearLog()'>Clear Log</button>"
-"<button class='btn' onclick='toggleAutoScroll()'>Toggle Auto-scroll</button>"
-"<button class='btn' onclick='downloadLog()'>Download Log</button>"
-"</div>"
-"<div class='log-container' id='logContainer'>"
-"<div class='log-entry system'>System starting up...</div>"
-"</div></div>"
-"<script>"
-"let ws=null,autoScroll=true,protocolCount=0,tradeCount=0,errorCount=0,connectionStartTime=null,logEntries=[];"
-"function connectWebSocket(){"
-"try{"
-"ws=new WebSocket('ws://192.168.7.1:8080');"
-"ws.onopen=function(e){console.log('WebSocket connected');connectionStartTime=Date.now();updateConnectionStatus('Connected - Real-time monitoring active',true);addLogEntry('system','WebSocket connected successfully')};"
-"ws.onmessage=function(e){try{const data=JSON.parse(e.data);handleWebSocketMessage(data)}catch(err){console.error('Error parsing WebSocket message:',err);addLogEntry('error','Failed to parse WebSocket message: '+err.message)}};"
-"ws.onclose=function(e){console.log('WebSocket disconnected');updateConnectionStatus('Disconnected - Attempting to reconnect...',false);addLogEntry('system','WebSocket disconnected, attempting to reconnect...');setTimeout(connectWebSocket,3000)};"
-"ws.onerror=function(e){console.error('WebSocket error:',e);addLogEntry('error','WebSocket error occurred')};"
-"}catch(e){console.error('Failed to create WebSocket:',e);updateConnectionStatus('Connection failed - Retrying...',false);setTimeout(connectWebSocket,3000)}}"
-"function handleWebSocketMessage(data){"
-"const timestamp=new Date().toLocaleTimeString();"
-"switch(data.type){"
-"case 'protocol':protocolCount++;addLogEntry('protocol',`[${timestamp}] PROTOCOL: RX: ${data.rx} → TX: ${data.tx} (${data.state})`);break;"
-"case 'trade_event':tradeCount++;addLogEntry('trade',`[${timestamp}] ${data.event}: ${data.message}`);break;"
-"case 'pokemon_update':addLogEntry('system',`[${timestamp}] Pokemon data updated`);break;"
-"case 'status_update':addLogEntry('system',`[${timestamp}] Status updated`);break;"
-"default:addLogEntry('system',`[${timestamp}] Unknown message type: ${data.type}`)}"
-"updateStats()}"
-"function addLogEntry(type,message){"
-"const logContainer=document.getElementById('logContainer');"
-"const logEntry=document.createElement('div');"
-"logEntry.className=`log-entry ${type}`;logEntry.textContent=message;"
-"logContainer.appendChild(logEntry);logEntries.push({type,message,timestamp:Date.now()});"
-"if(logEntries.length>1000){logEntries.shift();logContainer.removeChild(logContainer.firstChild)}"
-"if(autoScroll)logContainer.scrollTop=logContainer.scrollHeight;"
-"if(type==='error'){errorCount++;updateStats()}}"
-"function updateConnectionStatus(message,connected){"
-"const statusElement=document.getElementById('connectionStatus');"
-"statusElement.textContent=message;statusElement.className=connected?'status connected':'status disconnected'}"
-"function updateStats(){"
-"document.getElementById('protocolCount').textContent=protocolCount;"
-"document.getElementById('tradeCount').textContent=tradeCount;"
-"document.getElementById('errorCount').textContent=errorCount;"
-"if(connectionStartTime){"
-"const elapsed=Math.floor((Date.now()-connectionStartTime)/1000);"
-"const minutes=Math.floor(elapsed/60);const seconds=elapsed%60;"
-"document.getElementById('connectionTime').textContent=`${minutes}:${seconds.toString().padStart(2,'0')}`}}"
-"function clearLog(){document.getElementById('logContainer').innerHTML='';logEntries=[];protocolCount=0;tradeCount=0;errorCount=0;updateStats();addLogEntry('system','Log cleared')}"
-"function toggleAutoScroll(){autoScroll=!autoScroll;addLogEntry('system',`Auto-scroll ${autoScroll?'enabled':'disabled'}`)}"
-"function downloadLog(){"
-"const logText=logEntries.map(entry=>`[${new Date(entry.timestamp).toLocaleString()}] ${entry.type.toUpperCase()}: ${entry.message}`).join('\\n');"
-"const blob=new Blob([logText],{type:'text/plain'});const url=URL.createObjectURL(blob);"
-"const a=document.createElement('a');a.href=url;a.download=`pokemon_trading_log_${new Date().toISOString().slice(0,19).replace(/:/g,'-')}.txt`;a.click();URL.revokeObjectURL(url)}"
-"setInterval(updateStats,1000);connectWebSocket();"
-"</script></body></html>";
-
-static const char *cgi_options(int iIndex, int iNumParams, char *pcParam[], char *pcValue[]) {
+typedef enum {
+    HTTP_PARAM_U32,
+    HTTP_PARAM_BOOL,                    // "on" or "1"
+    HTTP_PARAM_TAG
+} http_param_type_t;
+
+typedef struct {
+    uint32_t present;                   // bit per http_param_id_t given
+    char etag[HTTP_ETAG_SIZE];
+    uint32_t since;
+    uint32_t store;
+    uint32_t state;
+    uint32_t log;
+    uint32_t index;
+    uint32_t rate;
+    uint32_t bytes;
+    bool debug;
+    bool reset;
+} http_query_t;
+
+typedef struct {
+    const char *name;
+    uint8_t type;
+    uint8_t offset;
+} http_param_t;
+
+static const http_param_t http_params[HTTP_PARAM_COUNT] = {
+    [HTTP_PARAM_ETAG]  = { "etag",  HTTP_PARAM_TAG,  offsetof(http_query_t, etag) },
+    [HTTP_PARAM_SINCE] = { "since", HTTP_PARAM_U32,  offsetof(http_query_t, since) },
+    [HTTP_PARAM_STORE] = { "store", HTTP_PARAM_U32,  offsetof(http_query_t, store) },
+    [HTTP_PARAM_STATE] = { "state", HTTP_PARAM_U32,  offsetof(http_query_t, state) },
+    [HTTP_PARAM_LOG]   = { "log",   HTTP_PARAM_U32,  offsetof(http_query_t, log) },
+    [HTTP_PARAM_INDEX] = { "index", HTTP_PARAM_U32,  offsetof(http_query_t, index) },
+    [HTTP_PARAM_DEBUG] = { "debug", HTTP_PARAM_BOOL, offsetof(http_query_t, debug) },
+    [HTTP_PARAM_RESET] = { "reset", HTTP_PARAM_BOOL, offsetof(http_query_t, reset) },
+    [HTTP_PARAM_RATE]  = { "rate",  HTTP_PARAM_U32,  offsetof(http_query_t, rate) },
+    [HTTP_PARAM_BYTES] = { "bytes", HTTP_PARAM_U32,  offsetof(http_query_t, bytes) }
+};
+
+#define HTTP_QUERY_HAS(query, param)    (((query)->present >> (param)) & 1)
+
+// The query of the request being routed, for the fs_open_custom() call that follows the CGI handler
+static http_query_t http_query;
+
+static void http_parse_query(http_query_t *query, int iNumParams, char *pcParam[], char *pcValue[]) {
+    memset(query, 0, sizeof(http_query_t));
     for (int i = 0; i < iNumParams; i++) {
-        if (!strcmp(pcParam[i], "debug")) {
-            debug_enable = (!strcmp(pcValue[i], "on"));
+        for (size_t id = 0; id < HTTP_PARAM_COUNT; id++) {
+            const http_param_t *param = &http_params[id];
+            if (strcmp(pcParam[i], param->name)) continue;
+            void *field = (uint8_t *)query + param->offset;
+            switch (param->type) {
+                case HTTP_PARAM_U32:
+                    *(uint32_t *)field = strtoul(pcValue[i], NULL, 10);
+                    break;
+                case HTTP_PARAM_BOOL:
+                    *(bool *)field = !strcmp(pcValue[i], "on") || !strcmp(pcValue[i], "1");
+                    break;
+                case HTTP_PARAM_TAG:
+                    strncpy((char *)field, pcValue[i], HTTP_ETAG_SIZE - 1);
+                    break;
+            }
+            query->present |= 1u << id;
+            break;
         }
     }
+}
+
+// Route actions, run by the CGI dispatcher before the answer is opened. They return the
+// file answering the request, NULL for the route's own.
+static uint32_t options_generation = 0;
+
+static const char *cgi_options(const http_query_t *query) {
+    if (HTTP_QUERY_HAS(query, HTTP_PARAM_DEBUG)) {
+        debug_enable = query->debug;
+        options_generation++;
+    }
     return STATUS_FILE;
 }
 
-static const char *cgi_pokemon_list(int iIndex, int iNumParams, char *pcParam[], char *pcValue[]) {
-    return POKEMON_FILE;
+static const char *cgi_trade_logs(const http_query_t *query) {
+    return HTTP_QUERY_HAS(query, HTTP_PARAM_SINCE) ? LOGS_TAIL_FILE : LOGS_FILE;
 }
 
-static const char *cgi_trade_logs(int iIndex, int iNumParams, char *pcParam[], char *pcValue[]) {
-    return LOGS_FILE;
+static const char *cgi_delete_pokemon(const http_query_t *query) {
+    if (HTTP_QUERY_HAS(query, HTTP_PARAM_INDEX)) pokemon_delete_stored(query->index);
+    return POKEMON_FILE;
 }
 
-static const char *cgi_trade_status(int iIndex, int iNumParams, char *pcParam[], char *pcValue[]) {
+static const char *cgi_send_pokemon(const http_query_t *query) {
+    if (HTTP_QUERY_HAS(query, HTTP_PARAM_INDEX)) link_core_request_send(query->index);
     return TRADE_FILE;
 }
 
-static const char *cgi_delete_pokemon(int iIndex, int iNumParams, char *pcParam[], char *pcValue[]) {
-    for (int i = 0; i < iNumParams; i++) {
-        if (!strcmp(pcParam[i], "index")) {
-            size_t index = atoi(pcValue[i]);
-            pokemon_delete_stored(index);
-            break;
+static const char *cgi_reset_trading(const http_query_t *query) {
+    link_core_request_reset();
+    return STATUS_FILE;
+}
+
+static const char *cgi_reset_usb_boot(const http_query_t *query) {
+    if (debug_enable) reset_usb_boot(0, 0);
+    return ROOT_PAGE;
+}
+
+static const char *cgi_link_stats(const http_query_t *query) {
+    if (query->reset) link_latency_reset();
+    return NULL;
+}
+
+// Responses of the polled endpoints carry an ETag made of the generation of what they show.
+// httpd does not hand request headers to the file system, so If-None-Match comes as a query
+// parameter instead: /status.json?etag=<tag> gets 304 Not Modified while the tag is current.
+// Status and log responses stay rendered until their generation moves on.
+#define HTTP_HEADER_RESERVE     160     // the headers are placed right before the cached body
+#define HTTP_STATUS_CACHE_SIZE  512
+#define HTTP_LOGS_CACHE_SIZE    FILE_BUFFER_SIZE
+
+static const char http_not_modified[] = "HTTP/1.0 304 Not Modified\r\n\r\n";
+
+// Whatever a response is served from while it is sent, fs_close_custom() drops the reference
+typedef struct {
+    uint16_t users;
+} http_ref_t;
+
+typedef struct {
+    http_ref_t ref;
+    bool valid;
+    uint32_t generation;
+    int start;
+    int len;
+    char *data;
+    size_t size;
+} http_cache_t;
+
+typedef size_t (*http_render_t)(char *buffer, size_t size);
+
+// Other dynamic responses are rendered into a buffer of their own that stays with the request
+// until fs_close_custom(), so parallel requests cannot overwrite each other's bytes. TCP gets
+// copies (HTTP_IS_DATA_VOLATILE in lwipopts.h), unacked data outlives the buffer. When all
+// are taken the request gets 503 and the client retries.
+#define HTTP_RENDER_BUFFERS     4
+#define HTTP_RENDER_BUFFER_SIZE 4096
+
+typedef struct {
+    http_ref_t ref;
+    char data[HTTP_RENDER_BUFFER_SIZE];
+} http_buffer_t;
+
+static http_buffer_t http_buffers[HTTP_RENDER_BUFFERS];
+
+// What the concurrency costs, reported in /diagnostics.json
+static struct {
+    uint16_t peak;                      // buffers in use at once
+    uint32_t exhausted;                 // requests turned away
+    uint32_t renders;
+    uint32_t render_us_max;
+} http_pool_stats;
+
+static const char http_unavailable[] = "HTTP/1.0 503 Service Unavailable\r\nRetry-After: 1\r\n\r\n";
+
+// Answers the file with a 503, for requests that find their resources all taken
+static void http_open_unavailable(struct fs_file *file) {
+    file->data = http_unavailable;
+    file->len = sizeof(http_unavailable) - 1;
+    file->index = file->len;
+    file->flags = FS_FILE_FLAGS_HEADER_INCLUDED;
+}
+
+// Takes a buffer from the pool, NULL when none is free
+static http_buffer_t *http_buffer_take(void) {
+    http_buffer_t *buffer = NULL;
+    uint16_t in_use = 1;
+    for (size_t i = 0; i < HTTP_RENDER_BUFFERS; i++) {
+        if (http_buffers[i].ref.users) {
+            in_use++;
+        } else if (buffer == NULL) {
+            buffer = &http_buffers[i];
         }
     }
-    return POKEMON_FILE;
+    if (buffer == NULL) return NULL;
+    if (in_use > http_pool_stats.peak) http_pool_stats.peak = in_use;
+    buffer->ref.users = 1;
+    return buffer;
 }
 
-static const char *cgi_send_pokemon(int iIndex, int iNumParams, char *pcParam[], char *pcValue[]) {
-    for (int i = 0; i < iNumParams; i++) {
-        if (!strcmp(pcParam[i], "index")) {
-            size_t index = atoi(pcValue[i]);
-            pokemon_send_stored(index);
-            break;
-        }
+// As http_buffer_take(), with the file set up for a 503 answer when none is free
+static http_buffer_t *http_buffer_alloc(struct fs_file *file) {
+    http_buffer_t *buffer = http_buffer_take();
+    if (buffer == NULL) {
+        http_pool_stats.exhausted++;
+        http_open_unavailable(file);
     }
-    return TRADE_FILE;
+    return buffer;
 }
 
-static const char *cgi_reset_trading(int iIndex, int iNumParams, char *pcParam[], char *pcValue[]) {
-    pokemon_trading_reset();
-    return STATUS_FILE;
+static int http_open_rendered(struct fs_file *file, http_render_t render) {
+    memset(file, 0, sizeof(struct fs_file));
+    http_buffer_t *buffer = http_buffer_alloc(file);
+    if (buffer == NULL) return 1;
+
+    uint64_t render_start = time_us_64();
+    file->len = render(buffer->data, sizeof(buffer->data));
+    uint32_t render_us = time_us_64() - render_start;
+    http_pool_stats.renders++;
+    if (render_us > http_pool_stats.render_us_max) http_pool_stats.render_us_max = render_us;
+
+    file->data = buffer->data;
+    file->index = file->len;
+    file->pextension = &buffer->ref;
+    return 1;
 }
 
-static const char *cgi_reset_usb_boot(int iIndex, int iNumParams, char *pcParam[], char *pcValue[]) {
-    if (debug_enable) reset_usb_boot(0, 0);
-    return ROOT_PAGE;
+static char status_cache_data[HTTP_STATUS_CACHE_SIZE];
+static char logs_cache_data[HTTP_LOGS_CACHE_SIZE];
+static http_cache_t status_cache = { .data = status_cache_data, .size = sizeof(status_cache_data) };
+static http_cache_t logs_cache = { .data = logs_cache_data, .size = sizeof(logs_cache_data) };
+
+// The ETag line is left out without an etag
+static int http_render_header(char *buffer, size_t size, size_t body_len, const char *etag) {
+    return snprintf(buffer, size,
+                    "HTTP/1.0 200 OK\r\n"
+                    "Content-Type: application/json\r\n"
+                    "Content-Length: %u\r\n"
+                    "Cache-Control: no-cache\r\n"
+                    "%s%s%s"
+                    "\r\n", (unsigned)body_len,
+                    etag ? "ETag: \"" : "", etag ? etag : "", etag ? "\"\r\n" : "");
 }
 
-static const char *cgi_diagnostics(int iIndex, int iNumParams, char *pcParam[], char *pcValue[]) {
-    memset(file_buffer, 0, sizeof(file_buffer));
-    
-    // Read raw GPIO states
-    bool sck_state = gpio_get(2);   // Clock pin
-    bool sin_state = gpio_get(0);   // Serial In pin (from Game Boy)
-    bool sout_state = gpio_get(3);  // Serial Out pin (to Game Boy)
-    
-    // Check PIO FIFO status
-    bool tx_fifo_empty = pio_sm_is_tx_fifo_empty(LINKCABLE_PIO, LINKCABLE_SM);
-    bool rx_fifo_empty = pio_sm_is_rx_fifo_empty(LINKCABLE_PIO, LINKCABLE_SM);
-    uint32_t rx_fifo_level = pio_sm_get_rx_fifo_level(LINKCABLE_PIO, LINKCABLE_SM);
-    uint32_t tx_fifo_level = pio_sm_get_tx_fifo_level(LINKCABLE_PIO, LINKCABLE_SM);
-    
+static bool http_open_not_modified(struct fs_file *file, const char *if_none_match, const char *etag) {
+    if (strcmp(if_none_match, etag)) return false;
+    memset(file, 0, sizeof(struct fs_file));
+    file->data = http_not_modified;
+    file->len = sizeof(http_not_modified) - 1;
+    file->index = file->len;
+    file->flags = FS_FILE_FLAGS_HEADER_INCLUDED;
+    return true;
+}
+
+// Serves the cached render, renders it first when the generation moved on. While the stale
+// render is still being sent to another client, this request gets an uncached one.
+static int http_open_cached(struct fs_file *file, http_cache_t *cache, char tag, uint32_t generation,
+                            const char *if_none_match, http_render_t render) {
+    char etag[HTTP_ETAG_SIZE];
+    snprintf(etag, sizeof(etag), "%c%lx", tag, (unsigned long)generation);
+    if (http_open_not_modified(file, if_none_match, etag)) return 1;
+
+    memset(file, 0, sizeof(struct fs_file));
+    if (!cache->valid || (cache->generation != generation)) {
+        if (cache->ref.users) return http_open_rendered(file, render);
+        char header[HTTP_HEADER_RESERVE];
+        size_t body_len = render(cache->data + HTTP_HEADER_RESERVE, cache->size - HTTP_HEADER_RESERVE);
+        int header_len = http_render_header(header, sizeof(header), body_len, etag);
+        cache->start = HTTP_HEADER_RESERVE - header_len;
+        memcpy(cache->data + cache->start, header, header_len);
+        cache->len = header_len + body_len;
+        cache->generation = generation;
+        cache->valid = true;
+    }
+    cache->ref.users++;
+    file->data = cache->data + cache->start;
+    file->len = cache->len;
+    file->index = file->len;
+    file->flags = FS_FILE_FLAGS_HEADER_INCLUDED;
+    file->pextension = &cache->ref;
+    return 1;
+}
+
+static void json_status(json_writer_t *json) {
+    json_object_begin(json);
+    json_key(json, "result");
+    json_string(json, "ok");
+    json_key(json, "options");
+    json_object_begin(json);
+    json_key(json, "debug");
+    json_string(json, debug_enable ? "on" : "off");
+    json_object_end(json);
+    json_key(json, "status");
+    json_object_begin(json);
+    json_key(json, "stored_pokemon");
+    json_uint(json, pokemon_get_stored_count());
+    json_key(json, "capacity");
+    json_uint(json, MAX_STORED_POKEMON);
+    json_key(json, "total_trades");
+    json_uint(json, total_trades);
+    json_key(json, "trade_state");
+    json_string(json, trade_state_to_string(pokemon_get_trade_state()));
+    json_object_end(json);
+    json_key(json, "system");
+    json_object_begin(json);
+    json_key(json, "fast");
+    json_bool(json, speed_240_MHz);
+    json_object_end(json);
+    json_object_end(json);
+}
+
+static size_t render_status(char *buffer, size_t size) {
+    json_writer_t json;
+    json_init(&json, buffer, size);
+    json_status(&json);
+    return json_length(&json);
+}
+
+// Appends the log lines from *seq on to an open string while reserve bytes stay free after them,
+// *seq ends up after the last one
+static void json_log_lines(json_writer_t *json, uint32_t *seq, size_t reserve) {
+    trade_event_t event;
+    char line[160];
+    uint32_t log_end = trade_log_end();
+    for (; *seq != log_end; (*seq)++) {
+        if (!trade_log_read(*seq, &event)) continue;
+        size_t len = trade_log_render(&event, line, sizeof(line));
+        if ((json_escaped_length(line, len) + reserve) > json_space(json)) break;
+        json_string_append(json, line, len);
+    }
+}
+
+static size_t render_logs(char *buffer, size_t size) {
+    json_writer_t json;
+    json_init(&json, buffer, size);
+    json_object_begin(&json);
+    json_key(&json, "logs");
+    json_string_begin(&json);
+
+    // The log is kept as binary records, render the newest lines that fit, oldest first
+    trade_event_t event;
+    char line[160];
+    uint32_t seq = trade_log_end();
+    size_t needed = 0;
+    while ((seq > trade_log_first()) && trade_log_read(seq - 1, &event)) {
+        size_t len = json_escaped_length(line, trade_log_render(&event, line, sizeof(line)));
+        if ((needed + len + 2) > json_space(&json)) break;
+        needed += len;
+        seq--;
+    }
+    json_log_lines(&json, &seq, 2);
+
+    json_string_end(&json);
+    json_object_end(&json);
+    return json_length(&json);
+}
+
+// Incremental log: /trade/logs?since=N answers with the lines from sequence number N on
+//   {"logs":"...","first":F,"head":H,"next":X,"missed":false}
+// "missed" means lines between N and the oldest one still in the ring (F) were overwritten
+// or N is from before a reboot, the lines then start at F.
+// "next" is the since of the following request, below "head" when not all lines fit.
+static uint32_t http_logs_since;
+
+static size_t render_logs_tail(char *buffer, size_t size) {
+    uint32_t first = trade_log_first();
+    uint32_t head = trade_log_end();
+    uint32_t seq = http_logs_since;
+    bool missed = ((int32_t)(seq - first) < 0) || ((int32_t)(head - seq) < 0);
+    if (missed) seq = first;
+
+    json_writer_t json;
+    json_init(&json, buffer, size);
+    json_object_begin(&json);
+    json_key(&json, "logs");
+    json_string_begin(&json);
+    json_log_lines(&json, &seq, 64);    // room for the trailing fields
+    json_string_end(&json);
+    json_key(&json, "first");
+    json_uint(&json, first);
+    json_key(&json, "head");
+    json_uint(&json, head);
+    json_key(&json, "next");
+    json_uint(&json, seq);
+    json_key(&json, "missed");
+    json_bool(&json, missed);
+    json_object_end(&json);
+    return json_length(&json);
+}
+
+static size_t render_trade(char *buffer, size_t size) {
     trade_session_t* session = pokemon_get_current_session();
-    
-    snprintf((char*)file_buffer, sizeof(file_buffer),
-        "{\"diagnostics\":{"
-        "\"gpio\":{\"sck\":%s,\"sin\":%s,\"sout\":%s},"
-        "\"pio\":{\"tx_empty\":%s,\"rx_empty\":%s,\"rx_level\":%lu,\"tx_level\":%lu},"
-        "\"session\":{\"state\":\"%s\",\"resets\":%lu},"
-        "\"debug_enabled\":%s"
-        "}}",
-        sck_state ? "true" : "false",
-        sin_state ? "true" : "false", 
-        sout_state ? "true" : "false",
-        tx_fifo_empty ? "true" : "false",
-        rx_fifo_empty ? "true" : "false",
-        rx_fifo_level,
-        tx_fifo_level,
-        trade_state_to_string(pokemon_get_trade_state()),
-        session->error_count,
-        debug_enable ? "true" : "false"
-    );
-    
-    return "/diagnostics.json";
+
+    json_writer_t json;
+    json_init(&json, buffer, size);
+    json_object_begin(&json);
+    json_key(&json, "trade_state");
+    json_string(&json, trade_state_to_string(session->state));
+    json_key(&json, "error");
+    json_string(&json, pokemon_get_last_error());
+    json_key(&json, "session_time");
+    json_uint(&json, session->session_start_time);
+    json_object_end(&json);
+    return json_length(&json);
 }
 
-static const char *cgi_gpio_monitor(int iIndex, int iNumParams, char *pcParam[], char *pcValue[]) {
-    memset(file_buffer, 0, sizeof(file_buffer));
-    
-    // Take multiple GPIO readings to catch transitions
-    char* buffer = (char*)file_buffer;
-    size_t remaining = sizeof(file_buffer);
+static size_t render_diagnostics(char *buffer, size_t size) {
+    uint32_t buffers_in_use = 0;
+    for (size_t i = 0; i < HTTP_RENDER_BUFFERS; i++) {
+        if (http_buffers[i].ref.users) buffers_in_use++;
+    }
     
-    int written = snprintf(buffer, remaining, "{\"gpio_samples\":[");
-    buffer += written;
-    remaining -= written;
+    trade_session_t* session = pokemon_get_current_session();
+    const ws_tx_stats_t* ws_stats = websocket_get_tx_stats();
     
-    // Sample GPIO states rapidly to catch any activity
-    for (int i = 0; i < 50 && remaining > 50; i++) {
-        bool sck = gpio_get(2);
-        bool sin = gpio_get(0);
-        bool sout = gpio_get(3);
-        
-        if (i > 0) {
-            written = snprintf(buffer, remaining, ",");
-            buffer += written;
-            remaining -= written;
+    json_writer_t json;
+    json_init(&json, buffer, size);
+    json_object_begin(&json);
+    json_key(&json, "diagnostics");
+    json_object_begin(&json);
+
+    // Raw GPIO states
+    json_key(&json, "gpio");
+    json_object_begin(&json);
+    json_key(&json, "sck");
+    json_bool(&json, gpio_get(2));      // Clock pin
+    json_key(&json, "sin");
+    json_bool(&json, gpio_get(0));      // Serial In pin (from Game Boy)
+    json_key(&json, "sout");
+    json_bool(&json, gpio_get(3));      // Serial Out pin (to Game Boy)
+    json_object_end(&json);
+
+    // PIO FIFO status
+    json_key(&json, "pio");
+    json_object_begin(&json);
+    json_key(&json, "tx_empty");
+    json_bool(&json, pio_sm_is_tx_fifo_empty(LINKCABLE_PIO, LINKCABLE_SM));
+    json_key(&json, "rx_empty");
+    json_bool(&json, pio_sm_is_rx_fifo_empty(LINKCABLE_PIO, LINKCABLE_SM));
+    json_key(&json, "rx_level");
+    json_uint(&json, pio_sm_get_rx_fifo_level(LINKCABLE_PIO, LINKCABLE_SM));
+    json_key(&json, "tx_level");
+    json_uint(&json, pio_sm_get_tx_fifo_level(LINKCABLE_PIO, LINKCABLE_SM));
+    json_object_end(&json);
+
+    json_key(&json, "session");
+    json_object_begin(&json);
+    json_key(&json, "state");
+    json_string(&json, trade_state_to_string(pokemon_get_trade_state()));
+    json_key(&json, "resets");
+    json_uint(&json, session->error_count);
+    json_key(&json, "dropped_events");
+    json_uint(&json, websocket_get_dropped_protocol_events());
+    json_object_end(&json);
+
+    json_key(&json, "websocket");
+    json_object_begin(&json);
+    json_key(&json, "clients");
+    json_uint(&json, websocket_get_connection_count());
+    json_key(&json, "frames");
+    json_uint(&json, ws_stats->frames);
+    json_key(&json, "frames_dropped");
+    json_uint(&json, ws_stats->frames_dropped);
+    json_key(&json, "bytes_dropped");
+    json_uint(&json, ws_stats->bytes_dropped);
+    json_key(&json, "stalls");
+    json_uint(&json, ws_stats->stalls);
+    json_object_end(&json);
+
+    const net_rx_stats_t *rx_stats = net_get_rx_stats();
+    json_key(&json, "net_rx");
+    json_object_begin(&json);
+    json_key(&json, "frames");
+    json_uint(&json, rx_stats->frames);
+    json_key(&json, "dropped");
+    json_uint(&json, rx_stats->dropped);
+    json_key(&json, "held");
+    json_uint(&json, rx_stats->held);
+    json_key(&json, "queue_peak");
+    json_uint(&json, rx_stats->high_water);
+    json_key(&json, "zero_copy");
+    json_bool(&json, NET_RX_ZERO_COPY);
+    json_key(&json, "copied");
+    json_uint(&json, rx_stats->copied);
+    json_key(&json, "queue_depth");
+    json_uint(&json, NET_RX_QUEUE_DEPTH);
+    json_object_end(&json);
+
+    const net_tx_stats_t *tx_stats = net_get_tx_stats();
+    json_key(&json, "net_tx");
+    json_object_begin(&json);
+    json_key(&json, "frames");
+    json_uint(&json, tx_stats->sent);
+    json_key(&json, "queued");
+    json_uint(&json, tx_stats->queued);
+    json_key(&json, "full");
+    json_uint(&json, tx_stats->full);
+    json_key(&json, "dropped");
+    json_uint(&json, tx_stats->dropped);
+    json_key(&json, "queue_peak");
+    json_uint(&json, tx_stats->high_water);
+    json_key(&json, "queue_depth");
+    json_uint(&json, NET_TX_QUEUE_DEPTH);
+    json_object_end(&json);
+
+    json_key(&json, "http");
+    json_object_begin(&json);
+    json_key(&json, "buffers");
+    json_uint(&json, HTTP_RENDER_BUFFERS);
+    json_key(&json, "buffer_size");
+    json_uint(&json, HTTP_RENDER_BUFFER_SIZE);
+    json_key(&json, "in_use");
+    json_uint(&json, buffers_in_use);
+    json_key(&json, "peak");
+    json_uint(&json, http_pool_stats.peak);
+    json_key(&json, "exhausted");
+    json_uint(&json, http_pool_stats.exhausted);
+    json_key(&json, "renders");
+    json_uint(&json, http_pool_stats.renders);
+    json_key(&json, "render_us_max");
+    json_uint(&json, http_pool_stats.render_us_max);
+    json_object_end(&json);
+
+    json_key(&json, "debug_enabled");
+    json_bool(&json, debug_enable);
+    json_object_end(&json);
+    json_object_end(&json);
+    return json_length(&json);
+}
+
+// /pokemon.json is generated while it is sent. fs_open_custom() only measures the listing for
+// the Content-Length, fs_read_custom() renders one slot at a time into lwIP's send buffer,
+// which httpd sizes to the free TCP send space. Memory per request is one record. The length
+// is measured again only when the store generation moved on. Slots that change during the
+// transfer render as deleted, so the body never outgrows the Content-Length sent for it.
+#define HTTP_STREAMS            4       // concurrent /pokemon.json requests
+#define HTTP_STREAM_RECORD      320     // one rendered slot
+#define HTTP_STREAM_TRAILER     (MAX_STORED_POKEMON + 1)
+
+typedef struct {
+    http_ref_t ref;
+    bool header;                        // HTTP headers still to come
+    bool first;
+    uint16_t next;                      // 0: opening, 1..MAX_STORED_POKEMON: slot + 1, then the trailer
+    uint16_t record_len;
+    uint16_t record_pos;
+    int body_len;
+    uint32_t generation;                // store generation the length was measured for
+    char etag[HTTP_ETAG_SIZE];
+    uint32_t slots[SLOT_BITMAP_WORDS(MAX_STORED_POKEMON)];  // occupancy the length was measured for
+    char record[HTTP_STREAM_RECORD];
+} http_stream_t;
+
+static http_stream_t http_streams[HTTP_STREAMS];
+
+static bool pokemon_length_valid = false;
+static uint32_t pokemon_length_generation;
+static int pokemon_length;
+
+static void json_pokemon_deleted(json_writer_t *json, size_t i) {
+    json_object_begin(json);
+    json_key(json, "slot");
+    json_uint(json, i);
+    json_key(json, "deleted");
+    json_bool(json, true);
+    json_object_end(json);
+}
+
+// One /pokemon.json array entry, a slot that is empty by now renders as deleted
+static void json_pokemon_slot(json_writer_t *json, size_t i) {
+    pokemon_slot_t slot;
+    const pokemon_data_t *pokemon = &slot.pokemon;
+    if (!pokemon_get_stored(i, &slot)) {
+        json_pokemon_deleted(json, i);
+        return;
+    }
+    json_object_begin(json);
+    json_key(json, "slot");
+    json_uint(json, i);
+    json_key(json, "species");
+    json_string(json, pokemon_get_species_name(pokemon->core.species));
+    json_key(json, "nickname");
+    json_string(json, pokemon->nickname);
+    json_key(json, "level");
+    json_uint(json, pokemon->core.level);
+    json_key(json, "type1");
+    json_string(json, pokemon_get_type_name(pokemon->core.type1));
+    json_key(json, "type2");
+    json_string(json, pokemon_get_type_name(pokemon->core.type2));
+    json_key(json, "trainer");
+    json_string(json, pokemon->ot_name);
+    json_key(json, "trainer_id");
+    json_uint(json, pokemon->core.original_trainer_id);
+    json_key(json, "timestamp");
+    json_uint(json, slot.timestamp);
+    json_key(json, "game");
+    json_string(json, slot.game_version);
+    json_object_end(json);
+}
+
+// Renders the next piece of the response into the record buffer, false after the last one
+static bool pokemon_stream_next(http_stream_t *stream) {
+    json_writer_t json;
+    json_init(&json, stream->record, HTTP_STREAM_RECORD);
+    stream->record_pos = 0;
+
+    if (stream->header) {
+        int written = http_render_header(stream->record, HTTP_STREAM_RECORD, stream->body_len, stream->etag);
+        stream->record_len = (written < HTTP_STREAM_RECORD) ? written : (HTTP_STREAM_RECORD - 1);
+        stream->header = false;
+        return true;
+    } else if (stream->next == 0) {
+        json_raw(&json, "{\"pokemon\":[", 12);
+        stream->next = 1;
+    } else {
+        if (stream->next > HTTP_STREAM_TRAILER) return false;
+        stream->next = slot_bitmap_next_set(stream->slots, MAX_STORED_POKEMON, stream->next - 1) + 1;
+        if (stream->next == HTTP_STREAM_TRAILER) {
+            json_raw(&json, "]}", 2);
+        } else {
+            size_t slot = stream->next - 1;
+            if (!stream->first) json_raw(&json, ",", 1);
+            if ((int32_t)(pokemon_get_slot_generation(slot) - stream->generation) > 0) {
+                // changed since the length was measured, the record may be longer now and
+                // the placeholder never is, the client reloads on the new generation anyway
+                json_pokemon_deleted(&json, slot);
+            } else {
+                json_pokemon_slot(&json, slot);
+            }
+            stream->first = false;
         }
-        
-        written = snprintf(buffer, remaining, 
-            "{\"sample\":%d,\"sck\":%s,\"sin\":%s,\"sout\":%s}",
-            i, 
-            sck ? "true" : "false",
-            sin ? "true" : "false",
-            sout ? "true" : "false"
-        );
-        buffer += written;
-        remaining -= written;
-        
-        // Small delay between samples
-        sleep_us(100);
+        stream->next++;
     }
-    
-    written = snprintf(buffer, remaining, "]}");
-    buffer += written;
-    
-    return "/gpio_monitor.json";
-}
-
-static const tCGI cgi_handlers[] = {
-    { "/options",           cgi_options },
-    { "/pokemon/list",      cgi_pokemon_list },
-    { "/pokemon/delete",    cgi_delete_pokemon },
-    { "/pokemon/send",      cgi_send_pokemon },
-    { "/trade/logs",        cgi_trade_logs },
-    { "/trade/status",      cgi_trade_status },
-    { "/reset",             cgi_reset_trading },
-    { "/reset_usb_boot",    cgi_reset_usb_boot },
-    { "/diagnostics",       cgi_diagnostics },
-    { "/gpio_monitor",      cgi_gpio_monitor }
-};
+    stream->record_len = json_length(&json);
+    return true;
+}
 
-int fs_open_custom(struct fs_file *file, const char *name) {
-    static const char *on_off[]     = {"off", "on"};
-    static const char *true_false[] = {"false", "true"};
-    
-    if (!strcmp(name, ROOT_PAGE) || !strcmp(name, "/")) {
-        memset(file, 0, sizeof(struct fs_file));
-        file->data = (const char *)pokemon_html;
-        file->len = strlen(pokemon_html);
-        file->index = file->len;
-        return 1;
+static int pokemon_stream_open(struct fs_file *file, const char *if_none_match) {
+    uint32_t generation = pokemon_get_generation(POKEMON_RESOURCE_STORE);
+    char etag[HTTP_ETAG_SIZE];
+    snprintf(etag, sizeof(etag), "p%lx", (unsigned long)generation);
+    if (http_open_not_modified(file, if_none_match, etag)) return 1;
+
+    http_stream_t *stream = NULL;
+    for (size_t i = 0; i < HTTP_STREAMS; i++) {
+        if (!http_streams[i].ref.users) {
+            stream = &http_streams[i];
+            break;
+        }
     }
-    else if (!strcmp(name, "/realtime_test.html")) {
+    if (stream == NULL) {
         memset(file, 0, sizeof(struct fs_file));
-        file->data = (const char *)realtime_test_html;
-        file->len = strlen(realtime_test_html);
-        file->index = file->len;
+        http_open_unavailable(file);
         return 1;
     }
-    else if (!strcmp(name, STATUS_FILE)) {
-        memset(file, 0, sizeof(struct fs_file));
-        file->data  = file_buffer;
-        file->len   = snprintf((char *)file_buffer, sizeof(file_buffer),
-                               "{\"result\":\"ok\"," \
-                               "\"options\":{\"debug\":\"%s\"}," \
-                               "\"status\":{\"stored_pokemon\":%zu,\"total_trades\":%lu,\"trade_state\":\"%s\"},"\
-                               "\"system\":{\"fast\":%s}}",
-                               on_off[debug_enable],
-                               pokemon_get_stored_count(),
-                               total_trades,
-                               trade_state_to_string(pokemon_get_trade_state()),
-                               true_false[speed_240_MHz]);
-        file->index = file->len;
-        return 1;
-    } 
-    else if (!strcmp(name, POKEMON_FILE)) {
-        memset(file, 0, sizeof(struct fs_file));
-        file->data = file_buffer;
-        
-        // Generate Pokemon list JSON
-        char *buffer = (char *)file_buffer;
-        size_t remaining = sizeof(file_buffer);
-        int written = snprintf(buffer, remaining, "{\"pokemon\":[");
-        buffer += written;
-        remaining -= written;
-        
-        pokemon_slot_t* pokemon_list = pokemon_get_stored_list();
-        size_t count = pokemon_get_stored_count();
-        bool first = true;
-        
-        for (size_t i = 0; i < MAX_STORED_POKEMON && remaining > 100; i++) {
-            if (!pokemon_list[i].occupied) continue;
-            
-            if (!first) {
-                written = snprintf(buffer, remaining, ",");
-                buffer += written;
-                remaining -= written;
-            }
-            first = false;
-            
-            const pokemon_data_t* pokemon = &pokemon_list[i].pokemon;
-            written = snprintf(buffer, remaining,
-                "{\"slot\":%zu,\"species\":\"%s\",\"nickname\":\"%s\",\"level\":%d,"
-                "\"type1\":\"%s\",\"type2\":\"%s\",\"trainer\":\"%s\","
-                "\"trainer_id\":%u,\"timestamp\":%lu,\"game\":\"%s\"}",
-                i,
-                pokemon_get_species_name(pokemon->core.species),
-                pokemon->nickname,
-                pokemon->core.level,
-                pokemon_get_type_name(pokemon->core.type1),
-                pokemon_get_type_name(pokemon->core.type2),
-                pokemon->ot_name,
-                pokemon->core.original_trainer_id,
-                pokemon_list[i].timestamp,
-                pokemon_list[i].game_version);
-            buffer += written;
-            remaining -= written;
+
+    memset(stream, 0, sizeof(http_stream_t));
+    stream->ref.users = 1;
+    strcpy(stream->etag, etag);
+    stream->generation = generation;
+    memcpy(stream->slots, pokemon_get_occupancy(), sizeof(stream->slots));
+
+    if (!pokemon_length_valid || (pokemon_length_generation != generation)) {
+        // measuring pass, renders every piece once without keeping it
+        int len = 0;
+        stream->first = true;
+        while (pokemon_stream_next(stream)) len += stream->record_len;
+        pokemon_length = len;
+        pokemon_length_generation = generation;
+        pokemon_length_valid = true;
+    }
+    stream->next = 0;
+    stream->first = true;
+    stream->body_len = pokemon_length;
+    stream->header = true;
+    pokemon_stream_next(stream);        // the headers, measures them too
+
+    memset(file, 0, sizeof(struct fs_file));
+    file->data = NULL;                  // generated by fs_read_custom()
+    file->len = stream->record_len + stream->body_len;
+    file->index = 0;
+    file->flags = FS_FILE_FLAGS_HEADER_INCLUDED;
+    file->pextension = &stream->ref;
+    return 1;
+}
+
+static int pokemon_stream_read(http_stream_t *stream, struct fs_file *file, char *buffer, int count) {
+    int read = 0;
+    if (count > (file->len - file->index)) count = file->len - file->index;
+    while (read < count) {
+        if (stream->record_pos == stream->record_len) {
+            if (pokemon_stream_next(stream)) continue;
+            // slots changed since the length was measured render shorter, pad up to Content-Length
+            memset(buffer + read, ' ', count - read);
+            read = count;
+            break;
         }
-        
-        written = snprintf(buffer, remaining, "]}");
-        buffer += written;
-        
-        file->len = buffer - (char *)file_buffer;
-        file->index = file->len;
-        return 1;
+        int chunk = stream->record_len - stream->record_pos;
+        if (chunk > (count - read)) chunk = count - read;
+        memcpy(buffer + read, stream->record + stream->record_pos, chunk);
+        stream->record_pos += chunk;
+        read += chunk;
     }
-    else if (!strcmp(name, LOGS_FILE)) {
-        memset(file, 0, sizeof(struct fs_file));
-        file->data = file_buffer;
-        
-        const char* logs = pokemon_get_trade_log();
-        char* buffer = (char*)file_buffer;
-        size_t remaining = sizeof(file_buffer);
-        
-        // Start JSON
-        int written = snprintf(buffer, remaining, "{\"logs\":\"");
-        buffer += written;
-        remaining -= written;
-        
-        // Escape logs string for JSON
-        if (logs && remaining > 10) {
-            const char* src = logs;
-            while (*src && remaining > 10) {
-                if (*src == '\n') {
-                    if (remaining > 2) {
-                        *buffer++ = '\\';
-                        *buffer++ = 'n';
-                        remaining -= 2;
-                    }
-                } else if (*src == '\r') {
-                    if (remaining > 2) {
-                        *buffer++ = '\\';
-                        *buffer++ = 'r';
-                        remaining -= 2;
-                    }
-                } else if (*src == '"') {
-                    if (remaining > 2) {
-                        *buffer++ = '\\';
-                        *buffer++ = '"';
-                        remaining -= 2;
-                    }
-                } else if (*src == '\\') {
-                    if (remaining > 2) {
-                        *buffer++ = '\\';
-                        *buffer++ = '\\';
-                        remaining -= 2;
-                    }
-                } else {
-                    *buffer++ = *src;
-                    remaining--;
-                }
-                src++;
+    file->index += read;
+    return read;
+}
+
+// Long-poll dashboard updates: /events.json?store=S&state=T&log=L is held until a generation
+// differs from the client's, then answers with what changed since: the status, the slots
+// changed after store generation S and the log lines from sequence number L. Without the
+// parameters it answers right away with the current generations.
+//   {"store":S,"state":T,"status":{...},"pokemon":[...],"logs_missed":true,"logs":"...","log":L}
+// "pokemon" is "reload" when the changed slots do not fit, "log" is where the client continues
+// when not all new lines fit. httpd waits through fs_canread_custom()/fs_wait_read_custom(),
+// http_events_process() in the main loop wakes it up. A waiter takes a render buffer only once
+// its answer is ready, so waiting requests do not starve the other endpoints of the pool.
+// /gpio_monitor.json?rate=R waits the same way, for the logic capture it starts to fill up.
+// Generations an /events.json client has seen
+typedef struct {
+    bool valid;                         // without them the answer carries the generations only
+    uint32_t store;
+    uint32_t state;
+    uint32_t log;                       // next trade log sequence number
+} http_events_query_t;
+
+#define HTTP_EVENTS_WAITERS     4
+#define HTTP_EVENTS_TIMEOUT_MS  5000    // answered unchanged before httpd's idle timeout closes
+#define HTTP_EVENTS_COALESCE_MS 50      // changes arriving together go out in one answer
+#define HTTP_CAPTURE_TIMEOUT_MS 1000    // a capture without SCK activity is answered untriggered
+
+typedef struct {
+    http_ref_t ref;
+    http_events_query_t query;
+    bool capture;                       // waits for the logic capture instead
+    struct fs_file *file;
+    http_buffer_t *buffer;              // taken when the answer is rendered, not while waiting
+    int start;
+    uint64_t opened;
+    bool ready;
+    fs_wait_cb callback;                // httpd waiting for the answer
+    void *callback_arg;
+} http_events_t;
+
+static http_events_t http_events[HTTP_EVENTS_WAITERS];
+
+static http_events_t *http_events_of(struct fs_file *file) {
+    for (size_t i = 0; i < HTTP_EVENTS_WAITERS; i++) {
+        if (file->pextension == &http_events[i].ref) return &http_events[i];
+    }
+    return NULL;
+}
+
+static uint32_t http_events_state_generation(void) {
+    // the options are part of the status too
+    return pokemon_get_generation(POKEMON_RESOURCE_STATE) + options_generation;
+}
+
+static bool http_events_changed(const http_events_query_t *query) {
+    return !query->valid ||
+           (query->store != pokemon_get_generation(POKEMON_RESOURCE_STORE)) ||
+           (query->state != http_events_state_generation()) ||
+           (query->log != pokemon_get_generation(POKEMON_RESOURCE_LOG));
+}
+
+static size_t render_events(const http_events_query_t *query, char *buffer, size_t size) {
+    uint32_t store = pokemon_get_generation(POKEMON_RESOURCE_STORE);
+    uint32_t state = http_events_state_generation();
+    uint32_t log_end = pokemon_get_generation(POKEMON_RESOURCE_LOG);
+    uint32_t log = query->valid ? query->log : log_end;
+
+    json_writer_t json;
+    json_init(&json, buffer, size);
+    json_object_begin(&json);
+    json_key(&json, "store");
+    json_uint(&json, store);
+    json_key(&json, "state");
+    json_uint(&json, state);
+
+    if (query->valid && ((query->store != store) || (query->state != state))) {
+        json_key(&json, "status");
+        json_status(&json);
+    }
+
+    if (query->valid && (query->store != store)) {
+        json_writer_t pokemon = json;   // where "reload" goes instead
+        bool reload = false;
+        json_key(&json, "pokemon");
+        json_array_begin(&json);
+        for (size_t i = 0; i < MAX_STORED_POKEMON; i++) {
+            if ((int32_t)(pokemon_get_slot_generation(i) - query->store) <= 0) continue;
+            if (json_space(&json) < (HTTP_STREAM_RECORD + 512)) {
+                // keep room for the log, the client loads the whole list instead
+                json = pokemon;
+                json_key(&json, "pokemon");
+                json_string(&json, "reload");
+                reload = true;
+                break;
             }
+            json_pokemon_slot(&json, i);
         }
-        
-        // End JSON
-        if (remaining > 3) {
-            written = snprintf(buffer, remaining, "\"}");
-            buffer += written;
-        }
-        
-        file->len = buffer - (char *)file_buffer;
-        file->index = file->len;
-        return 1;
+        if (!reload) json_array_end(&json);
     }
-    else if (!strcmp(name, TRADE_FILE)) {
-        memset(file, 0, sizeof(struct fs_file));
-        file->data = file_buffer;
-        
-        trade_session_t* session = pokemon_get_current_session();
-        const char* error = pokemon_get_last_error();
-        
-        char* buffer = (char*)file_buffer;
-        size_t remaining = sizeof(file_buffer);
-        
-        // Start JSON
-        int written = snprintf(buffer, remaining, 
-                             "{\"trade_state\":\"%s\",\"error\":\"", 
-                             trade_state_to_string(session->state));
-        buffer += written;
-        remaining -= written;
-        
-        // Escape error string for JSON
-        if (error && remaining > 10) {
-            const char* src = error;
-            while (*src && remaining > 10) {
-                if (*src == '\n') {
-                    if (remaining > 2) {
-                        *buffer++ = '\\';
-                        *buffer++ = 'n';
-                        remaining -= 2;
-                    }
-                } else if (*src == '\r') {
-                    if (remaining > 2) {
-                        *buffer++ = '\\';
-                        *buffer++ = 'r';
-                        remaining -= 2;
-                    }
-                } else if (*src == '"') {
-                    if (remaining > 2) {
-                        *buffer++ = '\\';
-                        *buffer++ = '"';
-                        remaining -= 2;
-                    }
-                } else if (*src == '\\') {
-                    if (remaining > 2) {
-                        *buffer++ = '\\';
-                        *buffer++ = '\\';
-                        remaining -= 2;
-                    }
-                } else {
-                    *buffer++ = *src;
-                    remaining--;
-                }
-                src++;
-            }
+
+    if (query->valid && (log != log_end)) {
+        bool missed = (int32_t)(log - trade_log_first()) < 0;
+        if (missed) {
+            log = trade_log_first();
+            json_key(&json, "logs_missed");
+            json_bool(&json, true);
         }
-        
-        // End JSON
-        if (remaining > 50) {
-            written = snprintf(buffer, remaining, "\",\"session_time\":%lu}", 
-                             session->session_start_time);
-            buffer += written;
+        json_key(&json, "logs");
+        json_string_begin(&json);
+        json_log_lines(&json, &log, 32);
+        json_string_end(&json);
+    }
+
+    // last, the lines that fit decide where the client continues
+    json_key(&json, "log");
+    json_uint(&json, log);
+    json_object_end(&json);
+    return json_length(&json);
+}
+
+static int http_events_open(struct fs_file *file, const http_events_query_t *query, bool capture) {
+    memset(file, 0, sizeof(struct fs_file));
+    http_events_t *events = NULL;
+    for (size_t i = 0; i < HTTP_EVENTS_WAITERS; i++) {
+        if (!http_events[i].ref.users) {
+            events = &http_events[i];
+            break;
         }
-        
-        file->len = buffer - (char *)file_buffer;
-        file->index = file->len;
-        return 1;
     }
-    else if (!strcmp(name, "/diagnostics.json")) {
-        memset(file, 0, sizeof(struct fs_file));
-        file->data = file_buffer;
-        
-        // Read raw GPIO states
-        bool sck_state = gpio_get(2);   // Clock pin
-        bool sin_state = gpio_get(0);   // Serial In pin (from Game Boy)
-        bool sout_state = gpio_get(3);  // Serial Out pin (to Game Boy)
-        
-        // Check PIO FIFO status
-        bool tx_fifo_empty = pio_sm_is_tx_fifo_empty(LINKCABLE_PIO, LINKCABLE_SM);
-        bool rx_fifo_empty = pio_sm_is_rx_fifo_empty(LINKCABLE_PIO, LINKCABLE_SM);
-        uint32_t rx_fifo_level = pio_sm_get_rx_fifo_level(LINKCABLE_PIO, LINKCABLE_SM);
-        
-        trade_session_t* session = pokemon_get_current_session();
-        
-        file->len = snprintf((char*)file_buffer, sizeof(file_buffer),
-            "{\"diagnostics\":{"
-            "\"gpio\":{\"sck\":%s,\"sin\":%s,\"sout\":%s},"
-            "\"pio\":{\"tx_empty\":%s,\"rx_empty\":%s,\"rx_level\":%lu},"
-            "\"session\":{\"state\":\"%s\",\"resets\":%lu}"
-            "}}",
-            sck_state ? "true" : "false",
-            sin_state ? "true" : "false", 
-            sout_state ? "true" : "false",
-            tx_fifo_empty ? "true" : "false",
-            rx_fifo_empty ? "true" : "false",
-            rx_fifo_level,
-            trade_state_to_string(pokemon_get_trade_state()),
-            session->error_count
-        );
-        
-        file->index = file->len;
+    if (events == NULL) {
+        http_open_unavailable(file);
         return 1;
     }
-    else if (!strcmp(name, "/gpio_monitor.json")) {
-        memset(file, 0, sizeof(struct fs_file));
-        file->data = file_buffer;
-        
-        // Take multiple GPIO readings to catch transitions
-        char* buffer = (char*)file_buffer;
-        size_t remaining = sizeof(file_buffer);
-        
-        int written = snprintf(buffer, remaining, "{\"gpio_samples\":[");
-        buffer += written;
-        remaining -= written;
-        
-        // Sample GPIO states rapidly to catch any activity
-        for (int i = 0; i < 50 && remaining > 50; i++) {
-            bool sck = gpio_get(2);
-            bool sin = gpio_get(0);
-            bool sout = gpio_get(3);
-            
-            if (i > 0) {
-                written = snprintf(buffer, remaining, ",");
-                buffer += written;
-                remaining -= written;
-            }
-            
-            written = snprintf(buffer, remaining, 
-                "{\"sample\":%d,\"sck\":%s,\"sin\":%s,\"sout\":%s}",
-                i, 
-                sck ? "true" : "false",
-                sin ? "true" : "false",
-                sout ? "true" : "false"
-            );
-            buffer += written;
-            remaining -= written;
-            
-            // Small delay between samples
-            sleep_us(100);
+    memset(events, 0, sizeof(http_events_t));
+    events->ref.users = 1;
+    events->query = *query;
+    events->capture = capture;
+    events->file = file;
+    events->opened = time_us_64();
+
+    file->data = NULL;                  // length and data once ready
+    file->len = 0;
+    file->index = 0;
+    file->flags = FS_FILE_FLAGS_HEADER_INCLUDED;
+    file->pextension = &events->ref;
+    return 1;
+}
+
+static void http_events_release(http_events_t *events) {
+    events->callback = NULL;
+    if (events->buffer) events->buffer->ref.users--;
+    events->buffer = NULL;
+}
+
+// Answers the waiting /events.json requests whose generations moved on or that timed out,
+// and the /gpio_monitor.json ones once their capture is complete
+void http_events_process(void) {
+    uint64_t now = time_us_64();
+    for (size_t i = 0; i < HTTP_EVENTS_WAITERS; i++) {
+        http_events_t *events = &http_events[i];
+        if (!events->ref.users || events->ready) continue;
+        uint64_t waited = now - events->opened;
+        if (events->capture) {
+            if (logic_capture_running() && (waited < MS(HTTP_CAPTURE_TIMEOUT_MS))) continue;
+        } else {
+            if (waited < MS(HTTP_EVENTS_COALESCE_MS)) continue;
+            if (!http_events_changed(&events->query) && (waited < MS(HTTP_EVENTS_TIMEOUT_MS))) continue;
+        }
+        // with the pool taken by other answers this one waits for the next pass
+        events->buffer = http_buffer_take();
+        if (events->buffer == NULL) continue;
+
+        char *data = events->buffer->data;
+        char *body = data + HTTP_HEADER_RESERVE;
+        size_t body_size = HTTP_RENDER_BUFFER_SIZE - HTTP_HEADER_RESERVE;
+        char header[HTTP_HEADER_RESERVE];
+        size_t body_len = events->capture ? logic_capture_render_json(body, body_size) :
+                                            render_events(&events->query, body, body_size);
+        int header_len = http_render_header(header, sizeof(header), body_len, NULL);
+        events->start = HTTP_HEADER_RESERVE - header_len;
+        memcpy(data + events->start, header, header_len);
+        events->file->len = header_len + body_len;
+        events->ready = true;
+
+        if (events->callback) {
+            // httpd may finish and close the file right away
+            fs_wait_cb callback = events->callback;
+            events->callback = NULL;
+            callback(events->callback_arg);
         }
-        
-        written = snprintf(buffer, remaining, "]}");
-        buffer += written;
-        
-        file->len = buffer - (char *)file_buffer;
-        file->index = file->len;
+    }
+}
+
+static int http_events_read(http_events_t *events, struct fs_file *file, char *buffer, int count) {
+    memcpy(buffer, events->buffer->data + events->start + file->index, count);
+    file->index += count;
+    return count;
+}
+
+// Throughput benchmark: /bench/download?bytes=N answers with N filler bytes made up while they
+// are sent, a POST to /bench/upload is counted and dropped. Both are timed on the device and
+// reported with the network profile in /bench.json. The download time runs from opening the
+// answer until httpd is done with it, so it ends once the last bytes are queued, not acked;
+// the client's own timing of the transfer is the one to trust.
+#define BENCH_BYTES_DEFAULT     (1024 * 1024)
+#define BENCH_BYTES_MAX         (64 * 1024 * 1024)
+
+typedef struct {
+    uint32_t bytes;
+    uint32_t us;
+} bench_result_t;
+
+typedef struct {
+    http_ref_t ref;
+    uint64_t opened;
+    int header_len;
+    char header[96];
+} http_bench_t;
+
+static http_bench_t http_bench;         // one download at a time
+static bench_result_t bench_download;
+static bench_result_t bench_upload;
+
+static struct {
+    void *connection;                   // the POST being counted
+    uint64_t started;
+    uint32_t bytes;
+} bench_upload_state;
+
+static bool http_bench_of(struct fs_file *file) {
+    return file->pextension == &http_bench.ref;
+}
+
+static int bench_open_download(struct fs_file *file, uint32_t bytes) {
+    memset(file, 0, sizeof(struct fs_file));
+    file->flags = FS_FILE_FLAGS_HEADER_INCLUDED;
+    if (http_bench.ref.users) {
+        http_open_unavailable(file);
         return 1;
     }
-    
-    return 0;
+    if (bytes > BENCH_BYTES_MAX) bytes = BENCH_BYTES_MAX;
+    http_bench.ref.users = 1;
+    http_bench.header_len = snprintf(http_bench.header, sizeof(http_bench.header),
+                                     "HTTP/1.0 200 OK\r\n"
+                                     "Content-Type: application/octet-stream\r\n"
+                                     "Content-Length: %lu\r\n"
+                                     "\r\n", (unsigned long)bytes);
+    http_bench.opened = time_us_64();
+    file->data = NULL;                  // generated by fs_read_custom()
+    file->len = http_bench.header_len + bytes;
+    file->pextension = &http_bench.ref;
+    return 1;
+}
+
+static int bench_read(struct fs_file *file, char *buffer, int count) {
+    int read = 0;
+    if (file->index < http_bench.header_len) {
+        read = http_bench.header_len - file->index;
+        if (read > count) read = count;
+        memcpy(buffer, http_bench.header + file->index, read);
+    }
+    memset(buffer + read, 'x', count - read);
+    file->index += count;
+    return count;
+}
+
+static void bench_close_download(struct fs_file *file) {
+    bench_download.bytes = (file->index > http_bench.header_len) ? (file->index - http_bench.header_len) : 0;
+    bench_download.us = time_us_64() - http_bench.opened;
+}
+
+// httpd's POST hooks, only /bench/upload takes a body
+err_t httpd_post_begin(void *connection, const char *uri, const char *http_request, u16_t http_request_len,
+                       int content_len, char *response_uri, u16_t response_uri_len, u8_t *post_auto_wnd) {
+    if (strcmp(uri, "/bench/upload")) {
+        strncpy(response_uri, "/404.html", response_uri_len);
+        return ERR_ARG;
+    }
+    // an upload that never finished does not block the next one
+    bench_upload_state.connection = connection;
+    bench_upload_state.started = time_us_64();
+    bench_upload_state.bytes = 0;
+    *post_auto_wnd = 1;
+    return ERR_OK;
+}
+
+err_t httpd_post_receive_data(void *connection, struct pbuf *p) {
+    if (connection == bench_upload_state.connection) bench_upload_state.bytes += p->tot_len;
+    pbuf_free(p);
+    return ERR_OK;
+}
+
+void httpd_post_finished(void *connection, char *response_uri, u16_t response_uri_len) {
+    if (connection != bench_upload_state.connection) return;
+    bench_upload.bytes = bench_upload_state.bytes;
+    bench_upload.us = time_us_64() - bench_upload_state.started;
+    bench_upload_state.connection = NULL;
+    strncpy(response_uri, BENCH_FILE, response_uri_len);
+}
+
+static void json_bench_result(json_writer_t *json, const char *name, const bench_result_t *result) {
+    json_key(json, name);
+    json_object_begin(json);
+    json_key(json, "bytes");
+    json_uint(json, result->bytes);
+    json_key(json, "us");
+    json_uint(json, result->us);
+    json_key(json, "kbit_s");
+    json_uint(json, result->us ? (uint32_t)(((uint64_t)result->bytes * 8000) / result->us) : 0);
+    json_object_end(json);
+}
+
+static size_t render_bench(char *buffer, size_t size) {
+    json_writer_t json;
+    json_init(&json, buffer, size);
+    json_object_begin(&json);
+    json_key(&json, "profile");
+    json_string(&json, NET_PROFILE_NAME);
+    json_key(&json, "tcp_mss");
+    json_uint(&json, TCP_MSS);
+    json_key(&json, "tcp_wnd");
+    json_uint(&json, TCP_WND);
+    json_key(&json, "tcp_snd_buf");
+    json_uint(&json, TCP_SND_BUF);
+    json_key(&json, "mem_size");
+    json_uint(&json, MEM_SIZE);
+    json_key(&json, "pbuf_pool");
+    json_uint(&json, PBUF_POOL_SIZE);
+    json_key(&json, "rx_queue");
+    json_uint(&json, NET_RX_QUEUE_DEPTH);
+    json_key(&json, "tx_queue");
+    json_uint(&json, NET_TX_QUEUE_DEPTH);
+    json_bench_result(&json, "download", &bench_download);
+    json_bench_result(&json, "upload", &bench_upload);
+    json_object_end(&json);
+    return json_length(&json);
+}
+
+int fs_read_custom(struct fs_file *file, char *buffer, int count) {
+    if ((file->pextension == NULL) || (file->index >= file->len)) return FS_READ_EOF;
+    if (count > (file->len - file->index)) count = file->len - file->index;
+
+    http_events_t *events = http_events_of(file);
+    if (events) return http_events_read(events, file, buffer, count);
+    if (http_bench_of(file)) return bench_read(file, buffer, count);
+    return pokemon_stream_read((http_stream_t *)file->pextension, file, buffer, count);
+}
+
+u8_t fs_canread_custom(struct fs_file *file) {
+    if (!file->is_custom_file) return 1;
+    http_events_t *events = http_events_of(file);
+    return (events == NULL) || events->ready;
+}
+
+u8_t fs_wait_read_custom(struct fs_file *file, fs_wait_cb callback_fn, void *callback_arg) {
+    http_events_t *events = http_events_of(file);
+    if ((events == NULL) || events->ready) return 0;
+    events->callback = callback_fn;
+    events->callback_arg = callback_arg;
+    return 1;
+}
+
+int fs_read_async_custom(struct fs_file *file, char *buffer, int count, fs_wait_cb callback_fn, void *callback_arg) {
+    if (!fs_canread_custom(file)) {
+        fs_wait_read_custom(file, callback_fn, callback_arg);
+        return FS_READ_DELAYED;
+    }
+    return fs_read_custom(file, buffer, count);
+}
+
+// Route handlers answering from fs_open_custom()
+static int open_status(struct fs_file *file, const http_query_t *query) {
+    // the options are only set through cgi_options()
+    uint32_t generation = pokemon_get_generation(POKEMON_RESOURCE_STORE) +
+                          pokemon_get_generation(POKEMON_RESOURCE_STATE) + options_generation;
+    return http_open_cached(file, &status_cache, 's', generation, query->etag, render_status);
+}
+
+static int open_pokemon(struct fs_file *file, const http_query_t *query) {
+    return pokemon_stream_open(file, query->etag);
+}
+
+static int open_logs(struct fs_file *file, const http_query_t *query) {
+    return http_open_cached(file, &logs_cache, 'l', pokemon_get_generation(POKEMON_RESOURCE_LOG),
+                            query->etag, render_logs);
+}
+
+static int open_logs_tail(struct fs_file *file, const http_query_t *query) {
+    http_logs_since = query->since;
+    return http_open_rendered(file, render_logs_tail);
+}
+
+static int open_events(struct fs_file *file, const http_query_t *query) {
+    http_events_query_t events = {
+        .valid = HTTP_QUERY_HAS(query, HTTP_PARAM_STORE) || HTTP_QUERY_HAS(query, HTTP_PARAM_STATE) ||
+                 HTTP_QUERY_HAS(query, HTTP_PARAM_LOG),
+        .store = query->store,
+        .state = query->state,
+        .log = query->log
+    };
+    return http_events_open(file, &events, false);
+}
+
+static int open_trade(struct fs_file *file, const http_query_t *query) {
+    return http_open_rendered(file, render_trade);
+}
+
+static int open_diagnostics(struct fs_file *file, const http_query_t *query) {
+    return http_open_rendered(file, render_diagnostics);
+}
+
+static int open_link_stats(struct fs_file *file, const http_query_t *query) {
+    return http_open_rendered(file, link_latency_render_json);
+}
+
+static int open_gpio_monitor(struct fs_file *file, const http_query_t *query) {
+    // requests arriving during a capture share it
+    if (!logic_capture_running()) {
+        logic_capture_start(HTTP_QUERY_HAS(query, HTTP_PARAM_RATE) ? query->rate : LOGIC_CAPTURE_RATE);
+    }
+    http_events_query_t capture = { 0 };
+    return http_events_open(file, &capture, true);
+}
+
+static int open_bench(struct fs_file *file, const http_query_t *query) {
+    return http_open_rendered(file, render_bench);
+}
+
+static int open_bench_download(struct fs_file *file, const http_query_t *query) {
+    return bench_open_download(file, HTTP_QUERY_HAS(query, HTTP_PARAM_BYTES) ? query->bytes : BENCH_BYTES_DEFAULT);
+}
+
+// Every endpoint is one route. Short names are aliases sharing the handler of their .json file.
+// The pages are not routes, they come gzipped with their headers from fs_pokemon/ through
+// pokemon_storage_fs.c.
+//
+// Routes that read the query or run an action are registered as lwIP CGIs, to get their query
+// parsed and the action run before the answer they name is opened. httpd looks CGIs up with a
+// linear strcmp() over that table for every request, so that part of the routing cost still
+// grows with those routes; the other routes stay out of the table. fs_open_custom() finds the
+// route through a perfect hash: the seed is searched at startup until every route has a bucket
+// of its own, a lookup is one hash and one compare whatever the number of routes.
+typedef struct {
+    const char *name;
+    const char *(*action)(const http_query_t *query);
+    int (*open)(struct fs_file *file, const http_query_t *query);
+    bool query;                         // open() reads the query
+} http_route_t;
+
+static const http_route_t http_routes[] = {
+    { STATUS_FILE,              NULL,               open_status,            true },
+    { POKEMON_FILE,             NULL,               open_pokemon,           true },
+    { LOGS_FILE,                NULL,               open_logs,              true },
+    { LOGS_TAIL_FILE,           NULL,               open_logs_tail,         true },
+    { EVENTS_FILE,              NULL,               open_events,            true },
+    { TRADE_FILE,               NULL,               open_trade,             false },
+    { DIAGNOSTICS_FILE,         NULL,               open_diagnostics,       false },
+    { LINK_STATS_FILE,          cgi_link_stats,     open_link_stats,        false },
+    { GPIO_MONITOR_FILE,        NULL,               open_gpio_monitor,      true },
+    { BENCH_FILE,               NULL,               open_bench,             false },
+    { "/options",               cgi_options,        NULL,                   false },
+    { "/pokemon/list",          NULL,               open_pokemon,           true },
+    { "/pokemon/delete",        cgi_delete_pokemon, NULL,                   false },
+    { "/pokemon/send",          cgi_send_pokemon,   NULL,                   false },
+    { "/trade/logs",            cgi_trade_logs,     NULL,                   false },
+    { "/trade/status",          NULL,               open_trade,             false },
+    { "/reset",                 cgi_reset_trading,  NULL,                   false },
+    { "/reset_usb_boot",        cgi_reset_usb_boot, NULL,                   false },
+    { "/diagnostics",           NULL,               open_diagnostics,       false },
+    { "/gpio_monitor",          NULL,               open_gpio_monitor,      true },
+    { "/link_stats",            cgi_link_stats,     open_link_stats,        false },
+    { "/bench",                 NULL,               open_bench,             false },
+    { "/bench/download",        NULL,               open_bench_download,    true }
+};
+
+#define HTTP_ROUTES             LWIP_ARRAYSIZE(http_routes)
+#define HTTP_ROUTE_BITS         7       // 128 buckets, a seed separating every route is found quickly
+#define HTTP_ROUTE_BUCKETS      (1u << HTTP_ROUTE_BITS)
+#define HTTP_ROUTE_SEEDS        4096    // tried before giving up
+#define HTTP_ROUTE_NONE         0xff
+
+_Static_assert(HTTP_ROUTES < HTTP_ROUTE_NONE, "route indexes must fit the buckets");
+
+// Perfect hash index into http_routes, set up by http_routes_init()
+static uint8_t http_route_buckets[HTTP_ROUTE_BUCKETS];
+static uint32_t http_route_seed;
+
+// The CGI table and the route of each entry
+static tCGI cgi_handlers[HTTP_ROUTES];
+static uint8_t cgi_routes[HTTP_ROUTES];
+static int cgi_count;
+
+static uint32_t http_route_bucket(uint32_t seed, const char *name) {
+    // FNV-1a from a seeded basis, the top bits depend on every character
+    uint32_t hash = 2166136261u ^ seed;
+    while (*name) hash = (hash ^ (uint8_t)*name++) * 16777619u;
+    return hash >> (32 - HTTP_ROUTE_BITS);
+}
+
+static const http_route_t *http_route_find(const char *name) {
+    uint8_t route = http_route_buckets[http_route_bucket(http_route_seed, name)];
+    if ((route == HTTP_ROUTE_NONE) || strcmp(http_routes[route].name, name)) return NULL;
+    return &http_routes[route];
+}
+
+// Gives every route a bucket of its own, false when two of them collide with this seed
+static bool http_routes_place(uint32_t seed) {
+    memset(http_route_buckets, HTTP_ROUTE_NONE, sizeof(http_route_buckets));
+    for (size_t i = 0; i < HTTP_ROUTES; i++) {
+        uint32_t bucket = http_route_bucket(seed, http_routes[i].name);
+        if (http_route_buckets[bucket] != HTTP_ROUTE_NONE) return false;
+        http_route_buckets[bucket] = i;
+    }
+    return true;
+}
+
+static const char *cgi_route(int iIndex, int iNumParams, char *pcParam[], char *pcValue[]) {
+    const http_route_t *route = &http_routes[cgi_routes[iIndex]];
+    http_parse_query(&http_query, iNumParams, pcParam, pcValue);
+    const char *answer = route->action ? route->action(&http_query) : NULL;
+    return answer ? answer : route->name;
+}
+
+static void http_routes_init(void) {
+    for (http_route_seed = 0; !http_routes_place(http_route_seed); http_route_seed++) {
+        if (http_route_seed == HTTP_ROUTE_SEEDS) panic("no collision free seed for the HTTP routes");
+    }
+
+    cgi_count = 0;
+    for (size_t i = 0; i < HTTP_ROUTES; i++) {
+        if (!http_routes[i].action && !http_routes[i].query) continue;
+        cgi_handlers[cgi_count].pcCGIName = http_routes[i].name;
+        cgi_handlers[cgi_count].pfnCGIHandler = cgi_route;
+        cgi_routes[cgi_count++] = i;
+    }
+}
+
+int fs_open_custom(struct fs_file *file, const char *name) {
+    // the query a CGI handler parsed is only meant for this request
+    http_query_t query = http_query;
+    memset(&http_query, 0, sizeof(http_query));
+
+    const http_route_t *route = http_route_find(name);
+    if ((route == NULL) || (route->open == NULL)) return 0;
+    return route->open(file, &query);
 }
 
 void fs_close_custom(struct fs_file *file) {
-    (void)(file);
+    http_events_t *events = http_events_of(file);
+    if (events) http_events_release(events);
+    if (http_bench_of(file)) bench_close_download(file);
+    http_ref_t *ref = (http_ref_t *)file->pextension;
+    if (ref) ref->users--;
 }
 
 // Main loop
@@ -682,17 +1345,15 @@ int main(void) {
     wait_for_netif_is_up();
     dhcpd_init();
     dns_init();
+    http_routes_init();
     httpd_init();
-    http_set_cgi_handlers(cgi_handlers, LWIP_ARRAYSIZE(cgi_handlers));
+    http_set_cgi_handlers(cgi_handlers, cgi_count);
 
     // Initialize WebSocket server for real-time updates
     websocket_server_init();
 
-    // Initialize link cable with Pokemon trading handler
-    linkcable_init(link_cable_ISR);
-
-    // Set up watchdog timer
-    add_alarm_in_us(MS(300), link_cable_watchdog, NULL, true);
+    // Initialize link cable with Pokemon trading handler and its watchdog, on core 1 when split
+    link_core_launch();
 
     LED_OFF;
 
@@ -701,15 +1362,23 @@ int main(void) {
     printf("Web interface: http://192.168.7.1\n");
     printf("WebSocket: ws://192.168.7.1:8080\n");
 
+    uint64_t link_stats_broadcast = time_us_64();
     while (true) {
         // Process USB
         tud_task();
         // Process network traffic
         service_traffic();
+        // Answer the waiting dashboard long polls
+        http_events_process();
         // Process WebSocket connections
         websocket_server_process();
-        // Update Pokemon trading state machine
-        pokemon_trading_update();
+        // Push link latency statistics
+        if ((time_us_64() - link_stats_broadcast) >= LINK_STATS_BROADCAST_INTERVAL) {
+            link_stats_broadcast = time_us_64();
+            if (websocket_get_connection_count()) websocket_broadcast_link_stats();
+        }
+        // Update Pokemon trading state machine, or pick up its events from core 1
+        link_core_process();
     }
 
     return 0;
@@ -9,6 +9,7 @@
 #include "pokemon_trading.h"
 #include "pokemon_data.h"
 #include "linkcable.h"
+#include "trade_log.h"
 
 bool debug_enable = ENABLE_DEBUG;
 bool speed_240_MHz = false;
@@ -54,21 +55,19 @@ void handle_usb_commands(void) {
                 
             } else if (strcmp(command_buffer, "list") == 0) {
                 printf("Stored Pokemon:\n");
-                pokemon_slot_t* pokemon_list = pokemon_get_stored_list();
-                size_t count = pokemon_get_stored_count();
+                pokemon_slot_t slot;
                 
-                for (size_t i = 0; i < MAX_STORED_POKEMON; i++) {
-                    if (pokemon_list[i].occupied) {
-                        const pokemon_data_t* pokemon = &pokemon_list[i].pokemon;
-                        printf("Slot %zu: %s (Lv.%d) - %s/%s - Trainer: %s (ID: 0x%04X)\n",
-                               i,
-                               pokemon_get_species_name(pokemon->core.species),
-                               pokemon->core.level,
-                               pokemon_get_type_name(pokemon->core.type1),
-                               pokemon_get_type_name(pokemon->core.type2),
-                               pokemon->ot_name,
-                               pokemon->core.original_trainer_id);
-                    }
+                for (size_t i = pokemon_next_stored(0); i < MAX_STORED_POKEMON; i = pokemon_next_stored(i + 1)) {
+                    if (!pokemon_get_stored(i, &slot)) continue;
+                    const pokemon_data_t* pokemon = &slot.pokemon;
+                    printf("Slot %zu: %s (Lv.%d) - %s/%s - Trainer: %s (ID: 0x%04X)\n",
+                           i,
+                           pokemon_get_species_name(pokemon->core.species),
+                           pokemon->core.level,
+                           pokemon_get_type_name(pokemon->core.type1),
+                           pokemon_get_type_name(pokemon->core.type2),
+                           pokemon->ot_name,
+                           pokemon->core.original_trainer_id);
                 }
                 
             } else if (strncmp(command_buffer, "delete ", 7) == 0) {
@@ -81,11 +80,12 @@ void handle_usb_commands(void) {
                 
             } else if (strcmp(command_buffer, "logs") == 0) {
                 printf("Trading Logs:\n");
-                const char* logs = pokemon_get_trade_log();
-                if (logs && strlen(logs) > 0) {
-                    printf("%s", logs);
-                } else {
-                    printf("No logs available\n");
+                trade_event_t event;
+                char line[160];
+                uint32_t end = trade_log_end();
+                if (trade_log_first() == end) printf("No logs available\n");
+                for (uint32_t seq = trade_log_first(); seq != end; seq++) {
+                    if (trade_log_read(seq, &event) && trade_log_render(&event, line, sizeof(line))) printf("%s", line);
                 }
                 
             } else if (strcmp(command_buffer, "reset") == 0) {
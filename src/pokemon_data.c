@@ -301,6 +301,9 @@ const char* trade_state_to_string(trade_state_t state) {
         case TRADE_STATE_CONNECTED: return "CONNECTED";
         case TRADE_STATE_RECEIVING_POKEMON: return "RECEIVING_POKEMON";
         case TRADE_STATE_SENDING_POKEMON: return "SENDING_POKEMON";
+        case TRADE_STATE_EXCHANGING_BLOCKS: return "EXCHANGING_BLOCKS";
+        case TRADE_STATE_PATCH_PREAMBLE: return "PATCH_PREAMBLE";
+        case TRADE_STATE_PATCH_DATA_EXCHANGE: return "PATCH_DATA_EXCHANGE";
         case TRADE_STATE_CONFIRMING: return "CONFIRMING";
         case TRADE_STATE_COMPLETE: return "COMPLETE";
         case TRADE_STATE_ERROR: return "ERROR";
@@ -2,30 +2,76 @@
 #include "pokemon_data.h"
 #include "linkcable.h"
 #include "websocket_server.h"
+#include "link_latency.h"
+#include "link_core.h"
+#include "trade_log.h"
 #include "pico/time.h"
 #include "hardware/gpio.h"
 #include "char_encode.h"
+#include "slot_bitmap.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
 
-// Global storage for Pokemon
-static pokemon_slot_t pokemon_storage[MAX_STORED_POKEMON];
-static size_t stored_pokemon_count = 0;
+// Global storage for Pokemon as parallel arrays: the 66-byte records keep both names in their Gen 1
+// encoding, the timestamps and game versions have arrays of their own and game versions are
+// interned: 75 bytes a slot with its store generation, where a pokemon_slot_t and its generation
+// took 96. The checksum is not stored, pokemon_get_stored() computes it from the record.
+// Names are encoded with the table they were decoded with after the trade, so they read back as
+// they were stored. The bitmap has the taken slots and their count.
+#define POKEMON_GAMES       8       // distinct game versions stored at once
+#define POKEMON_GAME_NONE   0xff    // the table was full of others
+
+typedef struct __attribute__((packed)) {
+    pokemon_core_data_t core;
+    uint8_t nickname[POKEMON_NAME_LENGTH];
+    uint8_t ot_name[POKEMON_OT_NAME_LENGTH];
+} pokemon_record_t;
+
+_Static_assert(sizeof(pokemon_record_t) == POKEMON_DATA_SIZE + POKEMON_NAME_LENGTH + POKEMON_OT_NAME_LENGTH,
+               "pokemon_record_t must not be padded");
+
+static pokemon_record_t pokemon_records[MAX_STORED_POKEMON];
+static uint32_t pokemon_timestamps[MAX_STORED_POKEMON];
+static uint8_t pokemon_games[MAX_STORED_POKEMON];
+static uint32_t pokemon_occupancy[SLOT_BITMAP_WORDS(MAX_STORED_POKEMON)];
+
+static struct {
+    char name[16];
+    uint16_t users;                 // slots storing it
+} pokemon_game_table[POKEMON_GAMES];
 
 // Current trading session
 static trade_session_t current_session;
 
-// Trade log buffer
-static char trade_log[2048];
-static size_t log_position = 0;
-
 // Global trade block for the Pokemon this device will offer
 static trade_block_t g_trade_block_to_send;
 
-// Error tracking
-static char last_error[128];
+// Error tracking, always a string literal so the log can keep a pointer to it
+static const char *last_error = "";
+
+// Trade state the last received byte was handled in, for the latency statistics
+static trade_state_t response_state = TRADE_STATE_IDLE;
+
+// Generation counters for the web endpoints, written here and read by core 0
+static volatile uint32_t store_generation = 0;
+static uint32_t slot_generation[MAX_STORED_POKEMON];
+static volatile uint32_t state_generation = 0;
+static trade_state_t generation_state = TRADE_STATE_IDLE;
+
+// Counts a state transition since the last call, the state is assigned all over the state machine
+static inline void pokemon_note_state(void) {
+    if (current_session.state != generation_state) {
+        generation_state = current_session.state;
+        state_generation++;
+    }
+}
+
+// Binary trade log record in the current state, rendered to text only when the log is read
+static inline void pokemon_trace(trade_event_id_t id, uint8_t rx, uint8_t tx, uint16_t counter, uint8_t arg) {
+    trade_log_event(id, current_session.state, rx, tx, counter, arg);
+}
 
 // Helper function to convert 0x50-terminated names to null-terminated C strings
 static void convert_pokemon_name_from_block(char* dest, const char* src, size_t dest_size) {
@@ -133,10 +179,55 @@ static bool pokemon_create_test_trade_block(trade_block_t* trade_data, uint8_t s
     return true;
 }
 
+#if POKEMON_TRADE_TX_LOOKAHEAD
+// Queue every response from the current preamble position to the last trade block byte.
+// None of them depend on what the Game Boy sends: preamble bytes are echoed, the master keeps
+// its own random number list and ignores ours, and the trade block is prepared in advance.
+static void pokemon_preload_exchange(size_t preamble_received) {
+    uint8_t sequence[SERIAL_RNS_LENGTH * 2 + SERIAL_TRADE_BLOCK_PREAMBLE_LENGTH];
+    size_t length = 0;
+
+    for (size_t i = preamble_received; i < SERIAL_RNS_LENGTH; i++) sequence[length++] = SERIAL_PREAMBLE_BYTE;
+    for (size_t i = 0; i < SERIAL_RNS_LENGTH; i++) sequence[length++] = PKMN_BLANK;
+    for (size_t i = 0; i < SERIAL_TRADE_BLOCK_PREAMBLE_LENGTH; i++) sequence[length++] = SERIAL_PREAMBLE_BYTE;
+
+    if (linkcable_tx_free() < length + sizeof(trade_block_t)) {
+        // fall back to answering byte by byte
+        pokemon_log_trade_event("DEBUG", "TX ring busy, lookahead exchange disabled for this trade");
+        return;
+    }
+    linkcable_tx_write(sequence, length);
+    linkcable_tx_write((const uint8_t*)&g_trade_block_to_send, sizeof(trade_block_t));
+    current_session.tx_preloaded = true;
+    pokemon_log_trade_event("SUBSTATE", "Preamble, random numbers and trade block queued ahead");
+}
+
+// The Game Boy left the expected sequence, drop whatever was queued ahead before answering
+static void pokemon_cancel_preload(void) {
+    if (!current_session.tx_preloaded) return;
+    linkcable_tx_flush();
+    current_session.tx_preloaded = false;
+}
+#else
+static inline void pokemon_preload_exchange(size_t preamble_received) { (void)preamble_received; }
+static inline void pokemon_cancel_preload(void) {}
+#endif
+
+// Answers the received byte, unless the lookahead exchange queued the answer already
+static void pokemon_answer(uint8_t response) {
+    if (current_session.tx_preloaded) {
+        link_latency_preloaded(response_state);
+    } else {
+        pokemon_send_trade_response(response);
+    }
+}
+
 void pokemon_trading_init(void) {
     // Clear all storage slots
-    memset(pokemon_storage, 0, sizeof(pokemon_storage));
-    stored_pokemon_count = 0;
+    memset(pokemon_records, 0, sizeof(pokemon_records));
+    memset(pokemon_games, POKEMON_GAME_NONE, sizeof(pokemon_games));
+    memset(pokemon_game_table, 0, sizeof(pokemon_game_table));
+    memset(pokemon_occupancy, 0, sizeof(pokemon_occupancy));
     
     // Initialize trading session
     memset(&current_session, 0, sizeof(current_session));
@@ -153,9 +244,8 @@ void pokemon_trading_init(void) {
     current_session.exchange_counter = 0;
     
     // Clear logs and errors
-    memset(trade_log, 0, sizeof(trade_log));
-    memset(last_error, 0, sizeof(last_error));
-    log_position = 0;
+    trade_log_init();
+    last_error = "";
     
     pokemon_log_trade_event("SYSTEM", "Pokemon trading system initialized");
     
@@ -168,13 +258,8 @@ void pokemon_trading_init(void) {
         memcpy(&g_trade_block_to_send, &test_trade_block, sizeof(trade_block_t));
         
         // Log message for the new test block creation:
-        char init_msg[128];
-        snprintf(init_msg, sizeof(init_msg), "Prepared test trade block. Player: %.7s, Pokemon: %.7s (Species: %d, Lvl: %d)", 
-                 g_trade_block_to_send.player_trainer_name, 
-                 g_trade_block_to_send.pokemon_nicknames[0], 
-                 g_trade_block_to_send.pokemon_data[0].species, 
-                 g_trade_block_to_send.pokemon_data[0].level);
-        pokemon_log_trade_event("SYSTEM", init_msg);
+        pokemon_trace(TRADE_EVENT_PREPARED, g_trade_block_to_send.pokemon_data[0].species, 0, 0,
+                      g_trade_block_to_send.pokemon_data[0].level);
     } else {
         pokemon_log_trade_event("ERROR", "Failed to create test trade block for Pikachu");
     }
@@ -194,17 +279,19 @@ void pokemon_trading_update(void) {
     uint8_t received_byte;
     bool data_available = false;
     
+    // picks up the transition of the previous call, some paths return early
+    pokemon_note_state();
+    
     // Try to receive data from link cable
     received_byte = linkcable_receive();
     if (received_byte != 0xFF) { // 0xFF typically means no data
         data_available = true;
+        response_state = current_session.state;
         
         // Log all received bytes for debugging
         extern bool debug_enable;
         if (debug_enable) {
-            char debug_msg[64];
-            snprintf(debug_msg, sizeof(debug_msg), "RX: 0x%02X (%d)", received_byte, received_byte);
-            pokemon_log_trade_event("RAW", debug_msg);
+            pokemon_trace(TRADE_EVENT_RAW_RX, received_byte, 0, 0, 0);
         }
     }
     
@@ -223,10 +310,7 @@ void pokemon_trading_update(void) {
             bool sin_state = gpio_get(0);   // Serial In pin (from Game Boy)
             bool sout_state = gpio_get(3);  // Serial Out pin (to Game Boy)
             
-            char gpio_msg[128];
-            snprintf(gpio_msg, sizeof(gpio_msg), "GPIO States - SCK:%d SIN:%d SOUT:%d", 
-                    sck_state, sin_state, sout_state);
-            pokemon_log_trade_event("DEBUG", gpio_msg);
+            pokemon_trace(TRADE_EVENT_GPIO, sck_state, sin_state, 0, sout_state);
         }
     }
     
@@ -260,9 +344,6 @@ void pokemon_trading_update(void) {
                         response = received_byte; // Echo the highlight byte
                         current_session.state = TRADE_STATE_WAITING_FOR_PARTNER;
                         pokemon_log_trade_event("STATE", "IDLE -> WAITING_PARTNER (Menu Highlight RX in IDLE)");
-                        char menu_idle_msg[64];
-                        snprintf(menu_idle_msg, sizeof(menu_idle_msg), "IDLE: RX:0x%02X -> TX:0x%02X (Menu Highlight)", received_byte, response);
-                        pokemon_log_trade_event("PROTOCOL", menu_idle_msg);
                         save_sequence_count = 0; // Reset save sequence
                         break;
 
@@ -270,9 +351,6 @@ void pokemon_trading_update(void) {
                         response = PKMN_BLANK; // Respond with BLANK (consistent with WAITING_FOR_PARTNER state's response)
                         current_session.state = TRADE_STATE_CONNECTED; // Transition to expect preamble
                         pokemon_log_trade_event("STATE", "IDLE -> CONNECTED (Trade Center Selected in IDLE)");
-                        char tc_selected_idle_msg[64];
-                        snprintf(tc_selected_idle_msg, sizeof(tc_selected_idle_msg), "IDLE: RX:0x%02X -> TX:0x%02X (Trade Center Selected)", received_byte, response);
-                        pokemon_log_trade_event("PROTOCOL", tc_selected_idle_msg);
                         save_sequence_count = 0; // Reset save sequence
                         break;
 
@@ -281,9 +359,6 @@ void pokemon_trading_update(void) {
                         current_session.state = TRADE_STATE_CONNECTED;
                         // The TRADE_STATE_CONNECTED handler will initialize its sub-state and counter.
                         pokemon_log_trade_event("STATE", "IDLE -> CONNECTED (Preamble 0xFD RX in IDLE)");
-                        char preamble_idle_msg[64];
-                        snprintf(preamble_idle_msg, sizeof(preamble_idle_msg), "IDLE: RX:0x%02X -> TX:0x%02X (Preamble Start)", received_byte, response);
-                        pokemon_log_trade_event("PROTOCOL", preamble_idle_msg);
                         save_sequence_count = 0; // Reset save sequence
                         break;
 
@@ -311,9 +386,7 @@ void pokemon_trading_update(void) {
                     // Catch-all for other unexpected bytes in IDLE, maybe reset or log
                     default:
                         response = PKMN_BLANK; // Safe default, Flipper might send PKMN_BREAK_LINK
-                        char unknown_idle_msg[64];
-                        snprintf(unknown_idle_msg, sizeof(unknown_idle_msg), "IDLE: RX:0x%02X -> TX:0x%02X (Unexpected)", received_byte, response);
-                        pokemon_log_trade_event("DEBUG", unknown_idle_msg);
+                        pokemon_trace(TRADE_EVENT_UNEXPECTED, received_byte, response, 0, 0);
                         // Consider resetting to CONN_FALSE like Flipper if connection seems broken
                         // For now, just echo blank and stay IDLE or let save_sequence_count manage transition.
                         break;
@@ -322,11 +395,8 @@ void pokemon_trading_update(void) {
                 current_session.session_start_time = to_us_since_boot(get_absolute_time()) / 1000;
                 pokemon_send_trade_response(response);
                 
-                char msg[64];
-                snprintf(msg, sizeof(msg), "IDLE RX: 0x%02X -> TX: 0x%02X (save_seq: %d)", 
-                        received_byte, response, save_sequence_count);
-                pokemon_log_trade_event("PROTOCOL", msg);
-                websocket_broadcast_protocol_data(received_byte, response, "IDLE");
+                trade_log_event(TRADE_EVENT_PROTOCOL, TRADE_STATE_IDLE, received_byte, response, save_sequence_count, 0);
+                websocket_broadcast_protocol_data(received_byte, response, TRADE_STATE_IDLE);
             }
             break;
             
@@ -403,11 +473,8 @@ void pokemon_trading_update(void) {
                 
                 pokemon_send_trade_response(response);
                 
-                char partner_msg[64];
-                snprintf(partner_msg, sizeof(partner_msg), "WAIT_PARTNER RX: 0x%02X -> TX: 0x%02X", 
-                        received_byte, response);
-                pokemon_log_trade_event("PROTOCOL", partner_msg);
-                websocket_broadcast_protocol_data(received_byte, response, "WAITING_FOR_PARTNER");
+                trade_log_event(TRADE_EVENT_PROTOCOL, TRADE_STATE_WAITING_FOR_PARTNER, received_byte, response, 0, 0);
+                websocket_broadcast_protocol_data(received_byte, response, TRADE_STATE_WAITING_FOR_PARTNER);
             }
             break;
             
@@ -431,6 +498,7 @@ void pokemon_trading_update(void) {
                     current_session.exchange_counter = 1; // Count this 0xFD
                     pokemon_log_trade_event("SUBSTATE", "CONNECTED -> INITIAL_PREAMBLE (0xFD from WAITING_FOR_PARTNER is 1st byte)");
                     pokemon_send_trade_response(SERIAL_PREAMBLE_BYTE); // Echo the 0xFD
+                    pokemon_preload_exchange(current_session.exchange_counter);
                     // We have processed the 0xFD that triggered the state change. We should wait for the next byte.
                     return; 
                 } else {
@@ -440,6 +508,7 @@ void pokemon_trading_update(void) {
                     current_session.exchange_counter = 0;
                     pokemon_log_trade_event("SUBSTATE", "CONNECTED -> INITIAL_PREAMBLE (Awaiting first 0xFD)");
                     // No response sent here; the response to 0xD4 (PKMN_BLANK) was handled by IDLE state.
+                    pokemon_preload_exchange(current_session.exchange_counter);
                     // We must wait for a new byte.
                     return; 
                 }
@@ -447,14 +516,13 @@ void pokemon_trading_update(void) {
             
             if (data_available) { // This will now process a *new* byte after the returns above
                 uint8_t response = received_byte; // Default: echo byte
+                uint8_t sub_state = current_session.trade_exchange_sub_state;
 
-                switch (current_session.trade_exchange_sub_state) {
+                switch (sub_state) {
                     case TRADE_SUBSTATE_INITIAL_PREAMBLE:
                         if (received_byte == SERIAL_PREAMBLE_BYTE) {
                             current_session.exchange_counter++;
-                            char log_msg[64];
-                            snprintf(log_msg, sizeof(log_msg), "Initial Preamble RX: 0x%02X (%zu/%d)", received_byte, current_session.exchange_counter, SERIAL_RNS_LENGTH);
-                            pokemon_log_trade_event("PROTOCOL_DETAIL", log_msg);
+                            pokemon_trace(TRADE_EVENT_PREAMBLE, received_byte, 0, current_session.exchange_counter, 0);
 
                             if (current_session.exchange_counter >= SERIAL_RNS_LENGTH) {
                                 current_session.trade_exchange_sub_state = TRADE_SUBSTATE_RANDOM_NUMBERS;
@@ -464,6 +532,7 @@ void pokemon_trading_update(void) {
                         } else {
                             // Unexpected byte during initial preamble
                             pokemon_log_trade_event("ERROR", "Unexpected byte during initial preamble, resetting to IDLE");
+                            pokemon_cancel_preload();
                             current_session.state = TRADE_STATE_IDLE;
                             current_session.trade_exchange_sub_state = TRADE_SUBSTATE_NONE;
                             response = PKMN_BLANK; // Or a cancel byte
@@ -474,9 +543,7 @@ void pokemon_trading_update(void) {
                         // GameBoy sends random numbers, Flipper echoes them.
                         // These are followed by more preamble bytes.
                         current_session.exchange_counter++;
-                        char log_msg_rn[64];
-                        snprintf(log_msg_rn, sizeof(log_msg_rn), "Random/Preamble2 RX: 0x%02X (%zu/%d)", received_byte, current_session.exchange_counter, SERIAL_RNS_LENGTH + SERIAL_TRADE_BLOCK_PREAMBLE_LENGTH);
-                        pokemon_log_trade_event("PROTOCOL_DETAIL", log_msg_rn);
+                        pokemon_trace(TRADE_EVENT_RANDOM, received_byte, 0, current_session.exchange_counter, 0);
 
                         if (current_session.exchange_counter >= (SERIAL_RNS_LENGTH + SERIAL_TRADE_BLOCK_PREAMBLE_LENGTH)) {
                             current_session.trade_exchange_sub_state = TRADE_SUBSTATE_NONE; // Reset sub-state for next main state
@@ -493,6 +560,7 @@ void pokemon_trading_update(void) {
                     
                     default:
                         pokemon_log_trade_event("ERROR", "Unknown trade_exchange_sub_state in CONNECTED state");
+                        pokemon_cancel_preload();
                         current_session.state = TRADE_STATE_IDLE;
                         current_session.trade_exchange_sub_state = TRADE_SUBSTATE_NONE;
                         response = PKMN_BLANK;
@@ -500,19 +568,20 @@ void pokemon_trading_update(void) {
                 }
 
                 // Handle cancellation specifically if it occurs during these sub-states
-                if (received_byte == PKMN_MENU_CANCEL_SELECTED) { 
+                // (random numbers take any value below 0xFD, 0xD6 included)
+                if (received_byte == PKMN_MENU_CANCEL_SELECTED && sub_state != TRADE_SUBSTATE_RANDOM_NUMBERS) { 
                     response = PKMN_MENU_CANCEL_SELECTED; // Echo
+                    pokemon_cancel_preload();
                     current_session.state = TRADE_STATE_IDLE;
                     current_session.trade_exchange_sub_state = TRADE_SUBSTATE_NONE;
                     pokemon_log_trade_event("STATE", "CONNECTED -> IDLE (Cancel 0xD6 during preamble/random)");
                 }
                 
-                pokemon_send_trade_response(response);
-                char connected_log_msg[128]; // Increased buffer size for more detailed logging
-                snprintf(connected_log_msg, sizeof(connected_log_msg), "CONNECTED RX:0x%02X->TX:0x%02X (SubState:%d, Cnt:%zu)", 
-                        received_byte, response, current_session.trade_exchange_sub_state, current_session.exchange_counter);
-                pokemon_log_trade_event("PROTOCOL", connected_log_msg);
-                websocket_broadcast_protocol_data(received_byte, response, "CONNECTED");
+                // in lookahead mode the response is already waiting in the TX ring
+                pokemon_answer(response);
+                trade_log_event(TRADE_EVENT_PROTOCOL, TRADE_STATE_CONNECTED, received_byte, response,
+                                current_session.exchange_counter, current_session.trade_exchange_sub_state);
+                websocket_broadcast_protocol_data(received_byte, response, TRADE_STATE_CONNECTED);
             }
             break;
             
@@ -533,13 +602,10 @@ void pokemon_trading_update(void) {
                     byte_to_send = PKMN_BLANK; 
                 }
 
-                pokemon_send_trade_response(byte_to_send);
+                pokemon_answer(byte_to_send);
                 
-                char exchange_log[128];
-                snprintf(exchange_log, sizeof(exchange_log), "EXCHANGE RX:0x%02X->TX:0x%02X (Byte %zu/%zu)", 
-                        received_byte, byte_to_send, current_session.incoming_pokemon_bytes_count + 1, sizeof(trade_block_t));
-                pokemon_log_trade_event("PROTOCOL_DETAIL", exchange_log);
-                websocket_broadcast_protocol_data(received_byte, byte_to_send, "EXCHANGING_BLOCKS");
+                pokemon_trace(TRADE_EVENT_EXCHANGE, received_byte, byte_to_send, current_session.incoming_pokemon_bytes_count + 1, 0);
+                websocket_broadcast_protocol_data(received_byte, byte_to_send, TRADE_STATE_EXCHANGING_BLOCKS);
 
                 current_session.incoming_pokemon_bytes_count++;
 
@@ -570,12 +636,8 @@ void pokemon_trading_update(void) {
                     convert_pokemon_name_from_block(current_session.incoming_pokemon.ot_name, current_session.incoming_trade_block_buffer.original_trainer_names[0], POKEMON_OT_NAME_LENGTH);
                     current_session.has_incoming_data = true;
 
-                    char parsed_msg[128];
-                    snprintf(parsed_msg, sizeof(parsed_msg), "Parsed incoming: %s (L%d) from %s", 
-                        current_session.incoming_pokemon.nickname, 
-                        current_session.incoming_pokemon.core.level, 
-                        current_session.incoming_pokemon.ot_name);
-                    pokemon_log_trade_event("TRADE", parsed_msg);
+                    pokemon_trace(TRADE_EVENT_RECEIVED, current_session.incoming_pokemon.core.species, 0, 0,
+                                  current_session.incoming_pokemon.core.level);
 
                     if (pokemon_validate_data(&current_session.incoming_pokemon)) { // Basic validation
                         pokemon_log_trade_event("VALIDATION", "Incoming Pokemon data appears valid (structurally).");
@@ -588,9 +650,11 @@ void pokemon_trading_update(void) {
                     } else {
                         pokemon_log_trade_event("ERROR", "Incoming Pokemon data failed validation after exchange.");
                         current_session.state = TRADE_STATE_ERROR;
-                        strcpy(last_error, "Invalid data in exchanged block");
+                        last_error = "Invalid data in exchanged block";
                     }
                     // Reset for next potential full exchange or different process
+                    // (the last preloaded byte answered the last block byte, confirmation is answered live)
+                    current_session.tx_preloaded = false;
                     current_session.trade_exchange_sub_state = TRADE_SUBSTATE_NONE;
                     current_session.exchange_counter = 0;
                     current_session.incoming_pokemon_bytes_count = 0;
@@ -604,35 +668,17 @@ void pokemon_trading_update(void) {
                 switch (received_byte) {
                     case TRADE_CONFIRM_BYTE: // 0x66 - Confirm trade
                         // Store the received Pokemon
-                        if (pokemon_store_received(&current_session.incoming_pokemon, "GAME_BOY")) {
+                        if (link_core_commit_trade(&current_session.incoming_pokemon, "GAME_BOY")) {
                             current_session.state = TRADE_STATE_COMPLETE;
                             pokemon_log_trade_event("STATE", "CONFIRMING → COMPLETE (store OK)");
                             pokemon_send_trade_response(TRADE_RESPONSE_SUCCESS);
                             
-                            char completion_msg[128];
-                            snprintf(completion_msg, sizeof(completion_msg), 
-                                    "Trade completed! Received %s (Lv.%d) from %s", 
-                                    pokemon_get_species_name(current_session.incoming_pokemon.core.species),
-                                    current_session.incoming_pokemon.core.level,
-                                    current_session.incoming_pokemon.ot_name);
-                            pokemon_log_trade_event("TRADE", completion_msg);
-                            
-                            // Mark the sent Pokemon as traded
-                            if (stored_pokemon_count > 1 && pokemon_storage[1].occupied) {
-                                char sent_msg[128];
-                                snprintf(sent_msg, sizeof(sent_msg), 
-                                        "Sent %s (Lv.%d) to partner", 
-                                        pokemon_get_species_name(pokemon_storage[1].pokemon.core.species),
-                                        pokemon_storage[1].pokemon.core.level);
-                                pokemon_log_trade_event("TRADE", sent_msg);
-                                
-                                // Remove Pokemon #2 from storage
-                                pokemon_delete_stored(1);
-                            }
+                            pokemon_trace(TRADE_EVENT_COMPLETED, current_session.incoming_pokemon.core.species, 0, 0,
+                                          current_session.incoming_pokemon.core.level);
                         } else {
                             current_session.state = TRADE_STATE_ERROR;
                             pokemon_log_trade_event("STATE", "CONFIRMING → ERROR (storage full)");
-                            strcpy(last_error, "Storage full - cannot complete trade");
+                            last_error = "Storage full - cannot complete trade";
                             pokemon_send_trade_response(TRADE_RESPONSE_STORAGE_FULL);
                         }
                         break;
@@ -657,9 +703,7 @@ void pokemon_trading_update(void) {
                     default:
                         // Echo unknown bytes during confirmation
                         pokemon_send_trade_response(received_byte);
-                        char confirm_msg[64];
-                        snprintf(confirm_msg, sizeof(confirm_msg), "Confirmation phase: 0x%02X", received_byte);
-                        pokemon_log_trade_event("DEBUG", confirm_msg);
+                        pokemon_trace(TRADE_EVENT_CONFIRM, received_byte, received_byte, 0, 0);
                         break;
                 }
             }
@@ -705,8 +749,7 @@ void pokemon_trading_update(void) {
 
 void pokemon_trading_reset(void) {
     // Clear all storage slots
-    // memset(pokemon_storage, 0, sizeof(pokemon_storage)); // Keep stored pokemon for now
-    // stored_pokemon_count = 0;
+    // memset(pokemon_occupancy, 0, sizeof(pokemon_occupancy)); // Keep stored pokemon for now
     
     current_session.state = TRADE_STATE_IDLE;
     pokemon_log_trade_event("STATE", "ANY → IDLE (system reset)");
@@ -725,62 +768,114 @@ void pokemon_trading_reset(void) {
     current_session.our_block_sent_this_exchange = false;
     current_session.trade_exchange_sub_state = TRADE_SUBSTATE_NONE;
     current_session.exchange_counter = 0;
+    pokemon_note_state();
 
     pokemon_log_trade_event("SYSTEM", "Pokemon trading system reset");
 }
 
+// Table index of the game version, shared by every slot storing the same one
+static uint8_t pokemon_game_intern(const char* game) {
+    uint8_t free = POKEMON_GAME_NONE;
+    for (uint8_t i = 0; i < POKEMON_GAMES; i++) {
+        if (!pokemon_game_table[i].users) {
+            if (free == POKEMON_GAME_NONE) free = i;
+        } else if (!strncmp(pokemon_game_table[i].name, game, sizeof(pokemon_game_table[i].name) - 1)) {
+            pokemon_game_table[i].users++;
+            return i;
+        }
+    }
+    if (free != POKEMON_GAME_NONE) {
+        strncpy(pokemon_game_table[free].name, game, sizeof(pokemon_game_table[free].name) - 1);
+        pokemon_game_table[free].name[sizeof(pokemon_game_table[free].name) - 1] = '\0';
+        pokemon_game_table[free].users = 1;
+    }
+    return free;
+}
+
+static void pokemon_game_release(uint8_t game) {
+    if (game != POKEMON_GAME_NONE) pokemon_game_table[game].users--;
+}
+
 bool pokemon_store_received(const pokemon_data_t* pokemon, const char* source_game) {
-    if (stored_pokemon_count >= MAX_STORED_POKEMON) {
+    // Lowest empty slot
+    size_t i = slot_bitmap_first_clear(pokemon_occupancy, MAX_STORED_POKEMON);
+    if (i >= MAX_STORED_POKEMON) {
         return false;
     }
-    
-    // Find first empty slot
-    for (size_t i = 0; i < MAX_STORED_POKEMON; i++) {
-        if (!pokemon_storage[i].occupied) {
-            pokemon_storage[i].occupied = true;
-            pokemon_storage[i].timestamp = to_us_since_boot(get_absolute_time()) / 1000;
-            memcpy(&pokemon_storage[i].pokemon, pokemon, sizeof(pokemon_data_t));
-            strncpy(pokemon_storage[i].game_version, source_game, 15);
-            pokemon_storage[i].game_version[15] = '\0';
-            pokemon_storage[i].checksum = pokemon_calculate_checksum(pokemon);
-            
-            stored_pokemon_count++;
-            
-            char log_msg[128];
-            snprintf(log_msg, sizeof(log_msg), "Stored %s (Lv.%d) in slot %zu", 
-                    pokemon_get_species_name(pokemon->core.species), 
-                    pokemon->core.level, i);
-            pokemon_log_trade_event("STORAGE", log_msg);
-            
-            return true;
-        }
+
+    pokemon_record_t *record = &pokemon_records[i];
+    memcpy(&record->core, &pokemon->core, sizeof(pokemon_core_data_t));
+    pokemon_str_to_encoded_array(record->nickname, pokemon->nickname, POKEMON_NAME_LENGTH, true);
+    pokemon_str_to_encoded_array(record->ot_name, pokemon->ot_name, POKEMON_OT_NAME_LENGTH, true);
+    pokemon_timestamps[i] = to_us_since_boot(get_absolute_time()) / 1000;
+    pokemon_games[i] = pokemon_game_intern(source_game);
+    slot_bitmap_set(pokemon_occupancy, i);
+
+    slot_generation[i] = ++store_generation;
+
+    pokemon_trace(TRADE_EVENT_STORED, pokemon->core.species, 0, i, pokemon->core.level);
+
+    return true;
+}
+
+bool pokemon_commit_trade(const pokemon_data_t* pokemon, const char* source_game) {
+    if (!pokemon_store_received(pokemon, source_game)) {
+        return false;
     }
-    
-    return false;
+
+    // Mark the sent Pokemon as traded
+    if (slot_bitmap_test(pokemon_occupancy, 1)) {
+        pokemon_trace(TRADE_EVENT_SENT, pokemon_records[1].core.species, 0, 0, pokemon_records[1].core.level);
+        
+        // Remove Pokemon #2 from storage
+        pokemon_delete_stored(1);
+    }
+    return true;
 }
 
-pokemon_slot_t* pokemon_get_stored_list(void) {
-    return pokemon_storage;
+bool pokemon_get_stored(size_t index, pokemon_slot_t* slot) {
+    if (index >= MAX_STORED_POKEMON || !slot_bitmap_test(pokemon_occupancy, index)) {
+        return false;
+    }
+
+    const pokemon_record_t *record = &pokemon_records[index];
+    uint8_t game = pokemon_games[index];
+    slot->occupied = true;
+    slot->timestamp = pokemon_timestamps[index];
+    memcpy(&slot->pokemon.core, &record->core, sizeof(pokemon_core_data_t));
+    pokemon_encoded_array_to_str_until_terminator(slot->pokemon.nickname, record->nickname, POKEMON_NAME_LENGTH);
+    pokemon_encoded_array_to_str_until_terminator(slot->pokemon.ot_name, record->ot_name, POKEMON_OT_NAME_LENGTH);
+    strcpy(slot->game_version, (game != POKEMON_GAME_NONE) ? pokemon_game_table[game].name : "");
+    slot->checksum = pokemon_calculate_checksum(&slot->pokemon);
+    return true;
 }
 
 size_t pokemon_get_stored_count(void) {
-    return stored_pokemon_count;
+    return slot_bitmap_count(pokemon_occupancy, MAX_STORED_POKEMON);
+}
+
+const uint32_t* pokemon_get_occupancy(void) {
+    return pokemon_occupancy;
+}
+
+size_t pokemon_next_stored(size_t index) {
+    return slot_bitmap_next_set(pokemon_occupancy, MAX_STORED_POKEMON, index);
 }
 
 bool pokemon_delete_stored(size_t index) {
-    if (index >= MAX_STORED_POKEMON || !pokemon_storage[index].occupied) {
+    if (index >= MAX_STORED_POKEMON || !slot_bitmap_test(pokemon_occupancy, index)) {
         return false;
     }
     
-    char log_msg[128];
-    snprintf(log_msg, sizeof(log_msg), "Deleted %s from slot %zu", 
-            pokemon_get_species_name(pokemon_storage[index].pokemon.core.species), 
-            index);
+    uint8_t species = pokemon_records[index].core.species;
     
-    memset(&pokemon_storage[index], 0, sizeof(pokemon_slot_t));
-    stored_pokemon_count--;
+    slot_bitmap_clear(pokemon_occupancy, index);
+    memset(&pokemon_records[index], 0, sizeof(pokemon_record_t));
+    pokemon_game_release(pokemon_games[index]);
+    pokemon_games[index] = POKEMON_GAME_NONE;
+    slot_generation[index] = ++store_generation;
     
-    pokemon_log_trade_event("STORAGE", log_msg);
+    pokemon_trace(TRADE_EVENT_DELETED, species, 0, index, 0);
     return true;
 }
 
@@ -790,7 +885,7 @@ bool pokemon_send_stored(size_t index) {
     // We might want to adapt this if we allow selecting from multiple prepared blocks.
 
     if (g_trade_block_to_send.pokemon_data[0].species == 0) { // Check if a Pokemon is actually prepared
-        snprintf(last_error, sizeof(last_error), "No Pokemon prepared in g_trade_block_to_send.");
+        last_error = "No Pokemon prepared in g_trade_block_to_send.";
         pokemon_log_trade_event("ERROR", last_error);
         return false;
     }
@@ -816,24 +911,15 @@ bool pokemon_send_stored(size_t index) {
     current_session.outgoing_pokemon.core.original_trainer_id = g_trade_block_to_send.pokemon_data[0].original_trainer_id;
 
 
-    char send_log[128];
-    snprintf(send_log, sizeof(send_log), "Preparing to send Pokemon: %s (Species: %d) from OT: %s",
-             current_session.outgoing_pokemon.nickname,
-             current_session.outgoing_pokemon.core.species,
-             current_session.outgoing_pokemon.ot_name);
-    pokemon_log_trade_event("TRADE_PREP", send_log);
-
     // Send the entire trade block. The linkcable_send_trade_block handles byte swapping.
     linkcable_send_trade_block(&g_trade_block_to_send);
 
     current_session.our_block_sent_this_exchange = true;
     current_session.state = TRADE_STATE_CONFIRMING; 
+    pokemon_note_state();
     // current_session.needs_internal_reset = true; // Not needed for confirming state typically
 
-    char state_log[128];
-    snprintf(state_log, sizeof(state_log), "Sent our trade block. Transitioning to CONFIRMING. Nick: %.7s, Species: %d",
-        g_trade_block_to_send.pokemon_nicknames[0], g_trade_block_to_send.pokemon_data[0].species);
-    pokemon_log_trade_event("STATE_TRANSITION", state_log);
+    pokemon_trace(TRADE_EVENT_BLOCK_SENT, g_trade_block_to_send.pokemon_data[0].species, 0, 0, 0);
     
     // Log the species ID that we are offering for simpler debugging
     // current_session.offered_pokemon_species = g_trade_block_to_send.pokemon_data[0].species;
@@ -849,6 +935,7 @@ bool pokemon_send_stored(size_t index) {
 }
 
 void pokemon_send_trade_response(uint8_t response_code) {
+    link_latency_tx(response_state);
     linkcable_send(response_code);
 }
 
@@ -864,26 +951,20 @@ trade_session_t* pokemon_get_current_session(void) {
     return &current_session;
 }
 
-void pokemon_log_trade_event(const char* event, const char* details) {
-    char timestamp[32];
-    uint32_t time_ms = to_us_since_boot(get_absolute_time()) / 1000;
-    snprintf(timestamp, sizeof(timestamp), "[%lu.%03lu]", 
-             time_ms / 1000, time_ms % 1000);
-    
-    char log_entry[256];
-    int len = snprintf(log_entry, sizeof(log_entry), "%s %s: %s\n", 
-                      timestamp, event, details);
-    
-    // Append to trade log buffer
-    if (log_position + len >= sizeof(trade_log)) {
-        log_position = 0;
+uint32_t pokemon_get_generation(pokemon_resource_t resource) {
+    switch (resource) {
+        case POKEMON_RESOURCE_STORE: return store_generation;
+        case POKEMON_RESOURCE_STATE: return state_generation;
+        // every record advances the log sequence number
+        case POKEMON_RESOURCE_LOG:   return trade_log_end();
+        default:                     return 0;
     }
-    
-    memcpy(trade_log + log_position, log_entry, len);
-    log_position += len;
-    trade_log[log_position] = '\0';
 }
 
-const char* pokemon_get_trade_log(void) {
-    return trade_log;
-} 
\ No newline at end of file
+uint32_t pokemon_get_slot_generation(size_t index) {
+    return (index < MAX_STORED_POKEMON) ? slot_generation[index] : 0;
+}
+
+void pokemon_log_trade_event(const char* event, const char* details) {
+    trade_log_text(current_session.state, event, details);
+}
@@ -0,0 +1,166 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "hardware/timer.h"
+#include "hardware/sync.h"
+
+#include "link_core.h"
+#include "trade_log.h"
+
+_Static_assert((TRADE_LOG_DEPTH & (TRADE_LOG_DEPTH - 1)) == 0, "TRADE_LOG_DEPTH must be a power of two");
+
+static trade_event_t trade_log[TRADE_LOG_DEPTH];
+static volatile uint32_t trade_log_seq = 0;
+
+#if LINK_CORE_SPLIT
+// both cores log, the state machine on core 1 and the storage on core 0
+static spin_lock_t *trade_log_lock;
+
+static inline uint32_t trade_log_lock_acquire(void) {
+    return spin_lock_blocking(trade_log_lock);
+}
+
+static inline void trade_log_lock_release(uint32_t status) {
+    spin_unlock(trade_log_lock, status);
+}
+#else
+static inline uint32_t trade_log_lock_acquire(void) {
+    return save_and_disable_interrupts();
+}
+
+static inline void trade_log_lock_release(uint32_t status) {
+    restore_interrupts(status);
+}
+#endif
+
+void trade_log_init(void) {
+#if LINK_CORE_SPLIT
+    if (!trade_log_lock) trade_log_lock = spin_lock_instance(spin_lock_claim_unused(true));
+#endif
+    uint32_t status = trade_log_lock_acquire();
+    memset(trade_log, 0, sizeof(trade_log));
+    trade_log_seq = 0;
+    trade_log_lock_release(status);
+}
+
+static inline void trade_log_append(const trade_event_t * event) {
+    uint32_t status = trade_log_lock_acquire();
+    trade_log[trade_log_seq & (TRADE_LOG_DEPTH - 1)] = *event;
+    trade_log_seq++;
+    trade_log_lock_release(status);
+}
+
+void trade_log_event(trade_event_id_t id, trade_state_t state, uint8_t rx, uint8_t tx, uint16_t counter, uint8_t arg) {
+    trade_event_t event = {
+        .time_us = time_us_64(),
+        .counter = counter,
+        .id = id,
+        .state = state,
+        .rx = rx,
+        .tx = tx,
+        .arg = arg
+    };
+    trade_log_append(&event);
+}
+
+void trade_log_text(trade_state_t state, const char * category, const char * text) {
+    trade_event_t event = {
+        .time_us = time_us_64(),
+        .category = category,
+        .text = text,
+        .id = TRADE_EVENT_TEXT,
+        .state = state
+    };
+    trade_log_append(&event);
+}
+
+uint32_t trade_log_first(void) {
+    uint32_t end = trade_log_seq;
+    return (end > TRADE_LOG_DEPTH) ? (end - TRADE_LOG_DEPTH) : 0;
+}
+
+uint32_t trade_log_end(void) {
+    return trade_log_seq;
+}
+
+bool trade_log_read(uint32_t seq, trade_event_t * event) {
+    uint32_t status = trade_log_lock_acquire();
+    uint32_t end = trade_log_seq;
+    bool valid = ((end - seq) - 1) < TRADE_LOG_DEPTH;  // seq < end and not overwritten, wrap safe
+    if (valid) *event = trade_log[seq & (TRADE_LOG_DEPTH - 1)];
+    trade_log_lock_release(status);
+    return valid;
+}
+
+size_t trade_log_render(const trade_event_t * event, char * buffer, size_t size) {
+    uint32_t time_ms = event->time_us / 1000;
+    const char * species = pokemon_get_species_name(event->rx);
+    int len = snprintf(buffer, size, "[%lu.%03lu] ", (unsigned long)(time_ms / 1000), (unsigned long)(time_ms % 1000));
+    if ((len < 0) || ((size_t)len >= size)) return 0;
+
+    char * line = buffer + len;
+    size_t remaining = size - len;
+    switch (event->id) {
+        case TRADE_EVENT_TEXT:
+            len = snprintf(line, remaining, "%s: %s\n", event->category, event->text);
+            break;
+        case TRADE_EVENT_RAW_RX:
+            len = snprintf(line, remaining, "RAW: RX: 0x%02X (%d)\n", event->rx, event->rx);
+            break;
+        case TRADE_EVENT_GPIO:
+            len = snprintf(line, remaining, "DEBUG: GPIO States - SCK:%d SIN:%d SOUT:%d\n", event->rx, event->tx, event->arg);
+            break;
+        case TRADE_EVENT_PROTOCOL:
+            len = snprintf(line, remaining, "PROTOCOL: %s RX:0x%02X->TX:0x%02X (SubState:%d, Cnt:%u)\n",
+                           trade_state_to_string(event->state), event->rx, event->tx, event->arg, event->counter);
+            break;
+        case TRADE_EVENT_UNEXPECTED:
+            len = snprintf(line, remaining, "DEBUG: %s: RX:0x%02X -> TX:0x%02X (Unexpected)\n",
+                           trade_state_to_string(event->state), event->rx, event->tx);
+            break;
+        case TRADE_EVENT_PREAMBLE:
+            len = snprintf(line, remaining, "PROTOCOL_DETAIL: Initial Preamble RX: 0x%02X (%u/%d)\n",
+                           event->rx, event->counter, SERIAL_RNS_LENGTH);
+            break;
+        case TRADE_EVENT_RANDOM:
+            len = snprintf(line, remaining, "PROTOCOL_DETAIL: Random/Preamble2 RX: 0x%02X (%u/%d)\n",
+                           event->rx, event->counter, SERIAL_RNS_LENGTH + SERIAL_TRADE_BLOCK_PREAMBLE_LENGTH);
+            break;
+        case TRADE_EVENT_EXCHANGE:
+            len = snprintf(line, remaining, "PROTOCOL_DETAIL: EXCHANGE RX:0x%02X->TX:0x%02X (Byte %u/%u)\n",
+                           event->rx, event->tx, event->counter, (unsigned)sizeof(trade_block_t));
+            break;
+        case TRADE_EVENT_CONFIRM:
+            len = snprintf(line, remaining, "DEBUG: Confirmation phase: 0x%02X\n", event->rx);
+            break;
+        case TRADE_EVENT_PREPARED:
+            len = snprintf(line, remaining, "SYSTEM: Prepared trade block: %s (Species: %d, Lvl: %d)\n", species, event->rx, event->arg);
+            break;
+        case TRADE_EVENT_RECEIVED:
+            len = snprintf(line, remaining, "TRADE: Parsed incoming: %s (L%d)\n", species, event->arg);
+            break;
+        case TRADE_EVENT_COMPLETED:
+            len = snprintf(line, remaining, "TRADE: Trade completed! Received %s (Lv.%d)\n", species, event->arg);
+            break;
+        case TRADE_EVENT_SENT:
+            len = snprintf(line, remaining, "TRADE: Sent %s (Lv.%d) to partner\n", species, event->arg);
+            break;
+        case TRADE_EVENT_STORED:
+            len = snprintf(line, remaining, "STORAGE: Stored %s (Lv.%d) in slot %u\n", species, event->arg, event->counter);
+            break;
+        case TRADE_EVENT_DELETED:
+            len = snprintf(line, remaining, "STORAGE: Deleted %s from slot %u\n", species, event->counter);
+            break;
+        case TRADE_EVENT_BLOCK_SENT:
+            len = snprintf(line, remaining, "STATE_TRANSITION: Sent our trade block (%s, Species: %d), transitioning to CONFIRMING\n", species, event->rx);
+            break;
+        default:
+            len = snprintf(line, remaining, "UNKNOWN: event %d\n", event->id);
+            break;
+    }
+    if ((len < 0) || ((size_t)len >= remaining)) return 0;
+    return (line + len) - buffer;
+}
@@ -27,13 +27,42 @@
  */
 
 #include "tusb_lwip_glue.h"
+#include "spsc_queue.h"
 #include "pico/unique_id.h"
 
 /* lwip context */
 static struct netif netif_data;
 
-/* shared between tud_network_recv_cb() and service_traffic() */
-static struct pbuf *received_frame = NULL;
+/* received frames, queued by tud_network_recv_cb() and handed to lwip by service_traffic() */
+SPSC_QUEUE_DEFINE(rx_queue, struct pbuf *, NET_RX_QUEUE_DEPTH);
+
+/* a frame left in the USB buffer while the queue was full, the OUT endpoint stays
+   unarmed (the host gets NAKs) until service_traffic() made room for it */
+static const uint8_t *held_frame = NULL;
+static uint16_t held_size = 0;
+
+static net_rx_stats_t rx_stats;
+
+#if NET_RX_ZERO_COPY
+/* a frame in the driver's receive buffer, wrapped as a pbuf without copying it.
+   The driver has one buffer: it is renewed when lwip frees the pbuf, or when lwip keeps
+   the pbuf past processing and its data is moved to a pool pbuf by rx_frame_detach() */
+typedef struct {
+    struct pbuf_custom pbuf;            /* first, lwip hands it back to rx_frame_free() */
+    const uint8_t *frame;
+    uint16_t size;
+    struct pbuf *copy;                  /* the data after rx_frame_detach() */
+    bool in_use;
+} rx_frame_t;
+
+static rx_frame_t rx_frames[NET_RX_ZERO_COPY_FRAMES];
+#endif
+
+/* frames lwip handed over while the IN endpoint was busy, referenced and not copied,
+   sent in order by tx_drain() */
+SPSC_QUEUE_DEFINE(tx_queue, struct pbuf *, NET_TX_QUEUE_DEPTH);
+
+static net_tx_stats_t tx_stats;
 
 /* this is used by this code, ./class/net/net_driver.c, and usb_descriptors.c */
 /* ideally speaking, this should be generated from the hardware's unique ID (if available) */
@@ -62,22 +91,44 @@ static const dhcp_config_t dhcp_config = {
     .entries = entries                          /* entries */
 };
 
+/* sends the queued frames the driver takes now, true when the queue is empty */
+static bool tx_drain(void) {
+    struct pbuf *p;
+    while (spsc_queue_peek(&tx_queue, &p)) {
+        if (!tud_network_can_xmit(p->tot_len)) return false;
+        /* tud_network_xmit_cb() copies the frame into the USB buffer before this returns */
+        tud_network_xmit(p, 0);
+        spsc_queue_pop(&tx_queue, &p);
+        pbuf_free(p);
+        tx_stats.sent++;
+    }
+    return true;
+}
+
 static err_t linkoutput_fn(struct netif *netif, struct pbuf *p) {
     (void)netif;
 
-    for (;;) {
-        /* if TinyUSB isn't ready, we must signal back to lwip that there is nothing we can do */
-        if (!tud_ready()) return ERR_USE;
+    /* if TinyUSB isn't ready, we must signal back to lwip that there is nothing we can do */
+    if (!tud_ready()) return ERR_USE;
 
-        /* if the network driver can accept another packet, we make it happen */
-        if (tud_network_can_xmit(p->tot_len)) {
-            tud_network_xmit(p, 0 /* unused for this example */);
-            return ERR_OK;
-        }
+    /* straight out when nothing is waiting ahead of it and the driver can take it */
+    if (tx_drain() && tud_network_can_xmit(p->tot_len)) {
+        tud_network_xmit(p, 0 /* unused for this example */);
+        tx_stats.sent++;
+        return ERR_OK;
+    }
 
-        /* transfer execution to TinyUSB in the hopes that it will finish transmitting the prior packet */
-        tud_task();
+    /* otherwise it waits for the endpoint, TCP does not touch a segment still referenced here */
+    if (spsc_queue_count(&tx_queue) >= NET_TX_QUEUE_DEPTH) {
+        /* TCP keeps the segment and sends it again later */
+        tx_stats.full++;
+        return ERR_MEM;
     }
+    pbuf_ref(p);
+    spsc_queue_push(&tx_queue, &p);
+    tx_stats.queued++;
+    if (spsc_queue_count(&tx_queue) > tx_stats.high_water) tx_stats.high_water = spsc_queue_count(&tx_queue);
+    return ERR_OK;
 }
 
 static err_t output_fn(struct netif *netif, struct pbuf *p, const ip_addr_t *addr) {
@@ -123,23 +174,98 @@ bool dns_query_proc(const char *name, ip4_addr_t *addr) {
     return false;
 }
 
-bool tud_network_recv_cb(const uint8_t *src, uint16_t size) {
-    /* this shouldn't happen, but if we get another packet before
-    parsing the previous, we must signal our inability to accept it */
-    if (received_frame) return false;
-
-    if (size) {
-        struct pbuf *p = pbuf_alloc(PBUF_RAW, size, PBUF_POOL);
+#if NET_RX_ZERO_COPY
+static void rx_frame_free(struct pbuf *p) {
+    rx_frame_t *frame = (rx_frame_t *)p;
+    bool detached = (frame->copy != NULL);
+    if (detached) pbuf_free(frame->copy);
+    frame->copy = NULL;
+    frame->in_use = false;
+    /* a detached frame gave the driver its buffer back already */
+    if (!detached) tud_network_recv_renew();
+}
 
-        if (p) {
-            /* pbuf_alloc() has already initialized struct; all we need to do is copy the data */
-            memcpy(p->payload, src, size);
+/* lwip kept the frame after processing it (data the application has not taken yet, a
+   request split over segments): it is copied into a pool pbuf so the driver can receive
+   again, as long as a wrapper is left for the next frame. Only the payload is moved, which
+   is why lwipopts.h does not queue out of order segments in this mode, their tcphdr would
+   still point into the driver's buffer */
+static void rx_frame_detach(void) {
+    rx_frame_t *kept = NULL;
+    bool spare = false;
+    for (size_t i = 0; i < NET_RX_ZERO_COPY_FRAMES; i++) {
+        if (!rx_frames[i].in_use) spare = true;
+        else if (!rx_frames[i].copy) kept = &rx_frames[i];
+    }
+    if (!kept || !spare) return;
+
+    /* a pool pbuf holds a whole frame, the payload is moved as one block */
+    struct pbuf *copy = pbuf_alloc(PBUF_RAW, kept->size, PBUF_POOL);
+    if (!copy) return;
+    if (copy->next) {
+        pbuf_free(copy);
+        return;
+    }
+    memcpy(copy->payload, kept->frame, kept->size);
+    struct pbuf *p = &kept->pbuf.pbuf;
+    p->payload = (uint8_t *)copy->payload + ((const uint8_t *)p->payload - kept->frame);
+    kept->copy = copy;
+    rx_stats.copied++;
+    tud_network_recv_renew();
+}
 
-            /* store away the pointer for service_traffic() to later handle */
-            received_frame = p;
+/* wraps the frame in the driver's buffer into a pbuf on the queue, false when no wrapper is free */
+static bool rx_queue_frame(const uint8_t *src, uint16_t size) {
+    rx_frame_t *frame = NULL;
+    for (size_t i = 0; i < NET_RX_ZERO_COPY_FRAMES; i++) {
+        if (!rx_frames[i].in_use) {
+            frame = &rx_frames[i];
+            break;
         }
     }
+    if (!frame || (spsc_queue_count(&rx_queue) >= NET_RX_QUEUE_DEPTH)) return false;
+
+    frame->in_use = true;
+    frame->frame = src;
+    frame->size = size;
+    frame->copy = NULL;
+    frame->pbuf.custom_free_function = rx_frame_free;
+    struct pbuf *p = pbuf_alloced_custom(PBUF_RAW, size, PBUF_REF, &frame->pbuf, (void *)src, size);
+    spsc_queue_push(&rx_queue, &p);
+#else
+/* copies a frame into a pbuf on the queue, false when the queue or the pbuf pool is full */
+static bool rx_queue_frame(const uint8_t *src, uint16_t size) {
+    if (spsc_queue_count(&rx_queue) >= NET_RX_QUEUE_DEPTH) return false;
+
+    struct pbuf *p = pbuf_alloc(PBUF_RAW, size, PBUF_POOL);
+    if (!p) return false;
+
+    /* a pool pbuf may be a chain, copy across all of it */
+    pbuf_take(p, src, size);
+    spsc_queue_push(&rx_queue, &p);
+#endif
+
+    rx_stats.frames++;
+    if (spsc_queue_count(&rx_queue) > rx_stats.high_water) rx_stats.high_water = spsc_queue_count(&rx_queue);
+    return true;
+}
 
+bool tud_network_recv_cb(const uint8_t *src, uint16_t size) {
+    /* returning false has the driver rearm the endpoint itself, the frame is gone */
+    if (!size) return false;
+
+    if (!rx_queue_frame(src, size)) {
+        /* keep the frame in the USB buffer and stop receiving until there is room */
+        held_frame = src;
+        held_size = size;
+        rx_stats.held++;
+        return true;
+    }
+
+#if !NET_RX_ZERO_COPY
+    /* the frame is copied, the next one can come in while this one waits */
+    tud_network_recv_renew();
+#endif
     return true;
 }
 
@@ -160,25 +286,55 @@ uint16_t tud_network_xmit_cb(uint8_t *dst, void *ref, uint16_t arg) {
 }
 
 void service_traffic(void) {
-    /* handle any packet received by tud_network_recv_cb() */
-    if (received_frame) {
-        ethernet_input(received_frame, &netif_data);
-        pbuf_free(received_frame);
-        received_frame = NULL;
+    /* handle the packets received by tud_network_recv_cb() */
+    struct pbuf *p;
+    while (spsc_queue_pop(&rx_queue, &p)) {
+        if (ethernet_input(p, &netif_data) != ERR_OK) pbuf_free(p);
+    }
+#if NET_RX_ZERO_COPY
+    rx_frame_detach();
+#endif
+
+    /* send what waited for the IN endpoint, tud_task() completed its transfers meanwhile */
+    tx_drain();
+
+    /* resume reception once the held frame fits */
+    if (held_frame && rx_queue_frame(held_frame, held_size)) {
+        held_frame = NULL;
+#if !NET_RX_ZERO_COPY
         tud_network_recv_renew();
+#endif
     }
     sys_check_timeouts();
 }
 
+const net_rx_stats_t *net_get_rx_stats(void) {
+    return &rx_stats;
+}
+
+const net_tx_stats_t *net_get_tx_stats(void) {
+    return &tx_stats;
+}
+
 void tud_network_init_cb(void)
 {
-    /* if the network is re-initializing and we have a leftover packet, we must do a cleanup */
-    if (received_frame) {
-        pbuf_free(received_frame);
-        received_frame = NULL;
+    /* if the network is re-initializing and we have leftover packets, we must do a cleanup */
+    struct pbuf *p;
+    while (spsc_queue_pop(&rx_queue, &p)) {
+        pbuf_free(p);
+        rx_stats.dropped++;
+    }
+    if (held_frame) {
+        held_frame = NULL;
+        rx_stats.dropped++;
+    }
+    while (spsc_queue_pop(&tx_queue, &p)) {
+        pbuf_free(p);
+        tx_stats.dropped++;
     }
 }
 
+
 void dhcpd_init(void) {
     while (dhserv_init(&dhcp_config) != ERR_OK);
 }
@@ -1,5 +1,9 @@
 #include "websocket_server.h"
 #include "tusb_lwip_glue.h"
+#include "link_latency.h"
+#include "spsc_queue.h"
+#include "json_writer.h"
+#include "hardware/sync.h"
 #include "lwip/tcp.h"
 #include "lwip/pbuf.h"
 #include "lwip/mem.h"
@@ -20,6 +24,19 @@ static const char base64_table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqr
 static struct tcp_pcb *ws_listening_pcb = NULL;
 static ws_connection_t *ws_connections = NULL;
 static uint32_t connection_count = 0;
+static ws_tx_stats_t ws_tx_totals;
+
+// Protocol events waiting for the next batch, written by the trade state machine
+typedef struct {
+    uint64_t time_us;
+    uint8_t rx_byte;
+    uint8_t tx_byte;
+    uint8_t state;
+} ws_protocol_event_t;
+
+SPSC_QUEUE_DEFINE(protocol_queue, ws_protocol_event_t, WS_PROTOCOL_QUEUE_DEPTH);
+static volatile uint32_t protocol_dropped = 0;
+static uint32_t protocol_last_batch = 0;
 
 // Simple SHA1 implementation for WebSocket handshake
 static void sha1_hash(const uint8_t *data, size_t len, uint8_t hash[20]);
@@ -28,9 +45,9 @@ static int strncasecmp_local(const char *s1, const char *s2, size_t n);
 static char *strstr_case_insensitive(const char *haystack, const char *needle);
 
 // WebSocket frame handling
-static err_t ws_parse_frame(struct pbuf *p, ws_frame_t *frame);
+static bool ws_rx_consume(ws_connection_t *conn, const uint8_t *data, size_t length);
 static err_t ws_send_frame(ws_connection_t *conn, uint8_t opcode, const uint8_t *payload, size_t length);
-static void ws_handle_frame(ws_connection_t *conn, ws_frame_t *frame);
+static bool ws_handle_frame(ws_connection_t *conn, ws_frame_t *frame);
 
 // Connection management
 static ws_connection_t *ws_create_connection(struct tcp_pcb *pcb);
@@ -41,7 +58,8 @@ static err_t ws_perform_handshake(ws_connection_t *conn, struct pbuf *p);
 static err_t ws_accept_callback(void *arg, struct tcp_pcb *newpcb, err_t err);
 static err_t ws_recv_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err);
 static void ws_error_callback(void *arg, err_t err);
-static err_t ws_close_callback(void *arg, struct tcp_pcb *tpcb);
+static err_t ws_sent_callback(void *arg, struct tcp_pcb *tpcb, u16_t len);
+static err_t ws_poll_callback(void *arg, struct tcp_pcb *tpcb);
 
 // Forward declaration for sys_now (defined in tusb_lwip_glue.c)
 extern uint32_t sys_now(void);
@@ -69,9 +87,143 @@ void websocket_server_init(void) {
     printf("WebSocket server listening on port %d\n", WS_LISTENING_PORT);
 }
 
+// Sends a frame to the connected clients on the JSON (binary == false) or the binary link channel
+static void ws_broadcast_link(bool binary, uint8_t opcode, const uint8_t *data, size_t length) {
+    for (ws_connection_t *conn = ws_connections; conn != NULL; conn = conn->next) {
+        if ((conn->state == WS_STATE_CONNECTED) && (conn->binary_link == binary)) {
+            ws_send_frame(conn, opcode, data, length);
+        }
+    }
+}
+
+static void ws_send_protocol_json(const ws_protocol_event_t *events, size_t count) {
+    static char json_buffer[WS_PROTOCOL_BATCH_MAX * 96];
+    static const char hex[] = "0123456789ABCDEF";
+    char byte[4] = { '0', 'x' };
+
+    json_writer_t json;
+    json_init(&json, json_buffer, sizeof(json_buffer));
+    json_object_begin(&json);
+    json_key(&json, "type");
+    json_string(&json, "protocol_batch");
+    json_key(&json, "dropped");
+    json_uint(&json, protocol_dropped);
+    json_key(&json, "events");
+    json_array_begin(&json);
+
+    for (size_t i = 0; (i < count) && (json_space(&json) > 96); i++) {
+        json_object_begin(&json);
+        json_key(&json, "rx");
+        byte[2] = hex[events[i].rx_byte >> 4];
+        byte[3] = hex[events[i].rx_byte & 0xF];
+        json_string_len(&json, byte, sizeof(byte));
+        json_key(&json, "tx");
+        byte[2] = hex[events[i].tx_byte >> 4];
+        byte[3] = hex[events[i].tx_byte & 0xF];
+        json_string_len(&json, byte, sizeof(byte));
+        json_key(&json, "state");
+        json_string(&json, trade_state_to_string((trade_state_t)events[i].state));
+        json_key(&json, "timestamp");
+        json_uint(&json, events[i].time_us / 1000);
+        json_object_end(&json);
+    }
+
+    json_array_end(&json);
+    json_object_end(&json);
+    ws_broadcast_link(false, WS_OPCODE_TEXT, (const uint8_t *)json_buffer, json_length(&json));
+}
+
+static void ws_send_protocol_binary(const ws_protocol_event_t *events, size_t count) {
+    static uint8_t frame[WS_LINK_FRAME_HEADER_SIZE + (WS_PROTOCOL_BATCH_MAX * WS_LINK_RECORD_SIZE)];
+    uint32_t base = (uint32_t)events[0].time_us;
+
+    frame[0] = WS_LINK_FRAME_EVENTS;
+    frame[1] = 0;
+    frame[2] = count & 0xFF;
+    frame[3] = (count >> 8) & 0xFF;
+    frame[4] = base & 0xFF;
+    frame[5] = (base >> 8) & 0xFF;
+    frame[6] = (base >> 16) & 0xFF;
+    frame[7] = (base >> 24) & 0xFF;
+
+    uint8_t *record = frame + WS_LINK_FRAME_HEADER_SIZE;
+    uint64_t previous = events[0].time_us;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t delta = events[i].time_us - previous;
+        if (delta > 0xFFFF) delta = 0xFFFF;
+        previous = events[i].time_us;
+        record[0] = events[i].state;
+        record[1] = events[i].rx_byte;
+        record[2] = events[i].tx_byte;
+        record[3] = delta & 0xFF;
+        record[4] = (delta >> 8) & 0xFF;
+        record += WS_LINK_RECORD_SIZE;
+    }
+    ws_broadcast_link(true, WS_OPCODE_BINARY, frame, record - frame);
+}
+
+static void ws_send_protocol_schema(ws_connection_t *conn) {
+    char json_buffer[512];
+    json_writer_t json;
+    json_init(&json, json_buffer, sizeof(json_buffer) - 1);
+    json_object_begin(&json);
+    json_key(&json, "type");
+    json_string(&json, "protocol_schema");
+    json_key(&json, "subprotocol");
+    json_string(&json, WS_SUBPROTOCOL_LINK_BINARY);
+    json_key(&json, "kind");
+    json_uint(&json, WS_LINK_FRAME_EVENTS);
+    json_key(&json, "header_size");
+    json_uint(&json, WS_LINK_FRAME_HEADER_SIZE);
+    json_key(&json, "record_size");
+    json_uint(&json, WS_LINK_RECORD_SIZE);
+    json_key(&json, "record");
+    json_array_begin(&json);
+    json_string(&json, "state");
+    json_string(&json, "rx");
+    json_string(&json, "tx");
+    json_string(&json, "dt_us");
+    json_array_end(&json);
+    json_key(&json, "states");
+    json_array_begin(&json);
+    for (int state = TRADE_STATE_IDLE; state <= TRADE_STATE_ERROR; state++) {
+        json_string(&json, trade_state_to_string((trade_state_t)state));
+    }
+    json_array_end(&json);
+    json_object_end(&json);
+    json_buffer[json_length(&json)] = '\0';
+    websocket_send_text(conn, json_buffer);
+}
+
+static void ws_flush_protocol_events(uint32_t current_time) {
+    if ((current_time - protocol_last_batch) < WS_PROTOCOL_BATCH_INTERVAL_MS &&
+        spsc_queue_count(&protocol_queue) < (WS_PROTOCOL_QUEUE_DEPTH / 2)) {
+        return;
+    }
+    protocol_last_batch = current_time;
+
+    bool json_clients = false, binary_clients = false;
+    for (ws_connection_t *conn = ws_connections; conn != NULL; conn = conn->next) {
+        if (conn->state != WS_STATE_CONNECTED) continue;
+        if (conn->binary_link) binary_clients = true; else json_clients = true;
+    }
+
+    static ws_protocol_event_t events[WS_PROTOCOL_BATCH_MAX];
+    size_t count;
+    do {
+        count = 0;
+        while ((count < WS_PROTOCOL_BATCH_MAX) && spsc_queue_pop(&protocol_queue, &events[count])) count++;
+        // with nobody watching the queue is just emptied
+        if (!count) break;
+        if (json_clients) ws_send_protocol_json(events, count);
+        if (binary_clients) ws_send_protocol_binary(events, count);
+    } while (count == WS_PROTOCOL_BATCH_MAX);
+}
+
 void websocket_server_process(void) {
     // Process ping/pong and cleanup
     uint32_t current_time = sys_now();
+    ws_flush_protocol_events(current_time);
     ws_connection_t *conn = ws_connections;
     ws_connection_t *prev = NULL;
     
@@ -123,7 +275,8 @@ static err_t ws_accept_callback(void *arg, struct tcp_pcb *newpcb, err_t err) {
     tcp_arg(newpcb, conn);
     tcp_recv(newpcb, ws_recv_callback);
     tcp_err(newpcb, ws_error_callback);
-    tcp_poll(newpcb, ws_close_callback, 10);
+    tcp_sent(newpcb, ws_sent_callback);
+    tcp_poll(newpcb, ws_poll_callback, WS_POLL_INTERVAL);
     
     printf("WebSocket: New connection accepted\n");
     return ERR_OK;
@@ -151,10 +304,9 @@ static err_t ws_recv_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, e
         pbuf_free(p);
         return result;
     } else if (conn->state == WS_STATE_CONNECTED) {
-        // Parse WebSocket frame
-        ws_frame_t frame;
-        if (ws_parse_frame(p, &frame) == ERR_OK) {
-            ws_handle_frame(conn, &frame);
+        // Frames may span segments and pbufs, the parser keeps its state in the connection
+        for (struct pbuf *q = p; q != NULL; q = q->next) {
+            if (!ws_rx_consume(conn, (const uint8_t *)q->payload, q->len)) break;   // connection closed
         }
         pbuf_free(p);
     } else {
@@ -172,12 +324,55 @@ static void ws_error_callback(void *arg, err_t err) {
     }
 }
 
-static err_t ws_close_callback(void *arg, struct tcp_pcb *tpcb) {
-    ws_connection_t *conn = (ws_connection_t *)arg;
-    printf("WebSocket: Connection closed\n");
-    if (conn) {
-        websocket_close_connection(conn);
+// Hands as much of the TX ring to lwIP as its send buffer takes, lwIP copies the bytes so
+// the ring space is free again right away
+static void ws_tx_flush(ws_connection_t *conn) {
+    bool written = false;
+    while ((conn->pcb != NULL) && (conn->tx_head != conn->tx_tail)) {
+        uint32_t offset = conn->tx_tail & (WS_TX_RING_SIZE - 1);
+        uint32_t chunk = conn->tx_head - conn->tx_tail;
+        if (chunk > (WS_TX_RING_SIZE - offset)) chunk = WS_TX_RING_SIZE - offset;   // up to the wrap
+        uint32_t room = tcp_sndbuf(conn->pcb);
+        if (room == 0) break;
+        if (chunk > room) chunk = room;
+
+        bool more = (conn->tx_tail + chunk) != conn->tx_head;
+        err_t err = tcp_write(conn->pcb, &conn->tx_ring[offset], chunk, TCP_WRITE_FLAG_COPY | (more ? TCP_WRITE_FLAG_MORE : 0));
+        if (err != ERR_OK) {
+            // out of segments, the sent/poll callback tries again
+            conn->tx_stats.stalls++;
+            ws_tx_totals.stalls++;
+            break;
+        }
+        conn->tx_tail += chunk;
+        written = true;
     }
+    if (written) tcp_output(conn->pcb);
+}
+
+static void ws_tx_put(ws_connection_t *conn, const uint8_t *data, size_t length) {
+    while (length) {
+        uint32_t offset = conn->tx_head & (WS_TX_RING_SIZE - 1);
+        size_t chunk = WS_TX_RING_SIZE - offset;
+        if (chunk > length) chunk = length;
+        memcpy(&conn->tx_ring[offset], data, chunk);
+        conn->tx_head += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+}
+
+static err_t ws_sent_callback(void *arg, struct tcp_pcb *tpcb, u16_t len) {
+    ws_connection_t *conn = (ws_connection_t *)arg;
+    (void)tpcb; (void)len;
+    if (conn) ws_tx_flush(conn);
+    return ERR_OK;
+}
+
+static err_t ws_poll_callback(void *arg, struct tcp_pcb *tpcb) {
+    ws_connection_t *conn = (ws_connection_t *)arg;
+    (void)tpcb;
+    if (conn) ws_tx_flush(conn);
     return ERR_OK;
 }
 
@@ -191,6 +386,7 @@ static ws_connection_t *ws_create_connection(struct tcp_pcb *pcb) {
     conn->pcb = pcb;
     conn->state = WS_STATE_HANDSHAKE;
     conn->last_ping_time = sys_now();
+    conn->rx_header_need = 2;
     
     // Add to connections list
     conn->next = ws_connections;
@@ -267,6 +463,14 @@ static err_t ws_perform_handshake(ws_connection_t *conn, struct pbuf *p) {
     char accept_key[32];
     base64_encode(sha1_hash_result, 20, accept_key);
     
+    // Binary link channel requested? The header lists the client's subprotocols, comma separated
+    char *protocol_header = strstr_case_insensitive(request, "Sec-WebSocket-Protocol:");
+    if (protocol_header != NULL) {
+        char *protocol_end = strstr(protocol_header, "\r\n");
+        char *found = strstr(protocol_header, WS_SUBPROTOCOL_LINK_BINARY);
+        conn->binary_link = (found != NULL) && ((protocol_end == NULL) || (found < protocol_end));
+    }
+    
     // Send handshake response
     char response[512];
     int response_len = snprintf(response, sizeof(response),
@@ -274,64 +478,177 @@ static err_t ws_perform_handshake(ws_connection_t *conn, struct pbuf *p) {
         "Upgrade: websocket\r\n"
         "Connection: Upgrade\r\n"
         "Sec-WebSocket-Accept: %s\r\n"
-        "\r\n", accept_key);
+        "%s"
+        "\r\n", accept_key,
+        conn->binary_link ? "Sec-WebSocket-Protocol: " WS_SUBPROTOCOL_LINK_BINARY "\r\n" : "");
     
     err_t err = tcp_write(conn->pcb, response, response_len, TCP_WRITE_FLAG_COPY);
     if (err == ERR_OK) {
         tcp_output(conn->pcb);
         conn->state = WS_STATE_CONNECTED;
         printf("WebSocket: Handshake completed\n");
+        if (conn->binary_link) ws_send_protocol_schema(conn);
     }
     
     free(request);
     return err;
 }
 
-static err_t ws_parse_frame(struct pbuf *p, ws_frame_t *frame) {
-    if (p->tot_len < 2) {
-        return ERR_VAL;
+// Sends a close frame with the status code, then closes. Frees the connection.
+static void ws_fail_connection(ws_connection_t *conn, uint16_t status) {
+    uint8_t payload[2] = { (uint8_t)(status >> 8), (uint8_t)(status & 0xFF) };
+    printf("WebSocket: Closing connection, status %u\n", status);
+    ws_send_frame(conn, WS_OPCODE_CLOSE, payload, sizeof(payload));
+    conn->state = WS_STATE_CLOSING;     // close frame is queued already
+    websocket_close_connection(conn);
+}
+
+// Copies and unmasks a payload piece. The mask phase carries over between pieces. Bytes are
+// handled one at a time up to a word aligned destination, then a word at a time with the
+// mask rotated to the current phase (little endian, like the RP2040).
+static void ws_unmask_copy(uint8_t *dst, const uint8_t *src, size_t length, const uint8_t mask[4], uint8_t *phase) {
+    uint8_t p = *phase;
+    while (length && ((uintptr_t)dst & 3)) {
+        *dst++ = *src++ ^ mask[p];
+        p = (p + 1) & 3;
+        length--;
+    }
+    if (length >= 4) {
+        uint32_t key = (uint32_t)mask[p] | ((uint32_t)mask[(p + 1) & 3] << 8) |
+                       ((uint32_t)mask[(p + 2) & 3] << 16) | ((uint32_t)mask[(p + 3) & 3] << 24);
+        uint32_t *word = (uint32_t *)dst;
+        for (; length >= 4; length -= 4, src += 4) {
+            uint32_t value;
+            memcpy(&value, src, 4);     // the pbuf payload need not be aligned
+            *word++ = value ^ key;
+        }
+        dst = (uint8_t *)word;
     }
-    
-    uint8_t *data = (uint8_t *)p->payload;
-    
-    frame->final = (data[0] & 0x80) != 0;
-    frame->opcode = data[0] & 0x0F;
-    frame->masked = (data[1] & 0x80) != 0;
-    
-    uint8_t payload_len = data[1] & 0x7F;
-    size_t header_len = 2;
-    
-    if (payload_len == 126) {
-        if (p->tot_len < 4) return ERR_VAL;
-        frame->payload_length = (data[2] << 8) | data[3];
-        header_len = 4;
-    } else if (payload_len == 127) {
-        if (p->tot_len < 10) return ERR_VAL;
-        // For simplicity, we don't support 64-bit lengths
-        return ERR_VAL;
-    } else {
-        frame->payload_length = payload_len;
+    while (length) {
+        *dst++ = *src++ ^ mask[p];
+        p = (p + 1) & 3;
+        length--;
     }
-    
-    if (frame->masked) {
-        if (p->tot_len < header_len + 4) return ERR_VAL;
-        frame->mask_key = *(uint32_t *)(data + header_len);
-        header_len += 4;
+    *phase = p;
+}
+
+// Validates a complete frame header and sets up the payload. Returns a close status, 0 if valid.
+static uint16_t ws_rx_start_frame(ws_connection_t *conn) {
+    const uint8_t *header = conn->rx_header;
+    uint8_t opcode = header[0] & 0x0F;
+    uint8_t length7 = header[1] & 0x7F;
+    uint64_t length = length7;
+
+    if (length7 == 126) {
+        length = ((uint16_t)header[2] << 8) | header[3];
+    } else if (length7 == 127) {
+        length = 0;
+        for (int i = 0; i < 8; i++) length = (length << 8) | header[2 + i];
+        if (length >> 63) return WS_CLOSE_PROTOCOL_ERROR;
+    }
+
+    // no extensions were negotiated and clients always mask
+    if ((header[0] & 0x70) || !(header[1] & 0x80)) return WS_CLOSE_PROTOCOL_ERROR;
+    memcpy(conn->rx_mask, &header[conn->rx_header_need - 4], 4);
+    conn->rx_mask_phase = 0;
+    conn->rx_opcode = opcode;
+    conn->rx_final = (header[0] & 0x80) != 0;
+    conn->rx_remaining = length;
+
+    switch (opcode) {
+        case WS_OPCODE_CLOSE:
+        case WS_OPCODE_PING:
+        case WS_OPCODE_PONG:
+            // control frames may arrive between the fragments of a message
+            if (!conn->rx_final || (length > WS_RX_CONTROL_SIZE)) return WS_CLOSE_PROTOCOL_ERROR;
+            conn->rx_control_len = 0;
+            return 0;
+
+        case WS_OPCODE_TEXT:
+        case WS_OPCODE_BINARY:
+            if (conn->rx_message_opcode != 0) return WS_CLOSE_PROTOCOL_ERROR;
+            conn->rx_message_opcode = opcode;
+            conn->rx_message_len = 0;
+            break;
+
+        case WS_OPCODE_CONTINUATION:
+            if (conn->rx_message_opcode == 0) return WS_CLOSE_PROTOCOL_ERROR;
+            break;
+
+        default:
+            return WS_CLOSE_PROTOCOL_ERROR;
     }
-    
-    if (p->tot_len < header_len + frame->payload_length) {
-        return ERR_VAL;
+    if (length > (uint64_t)(WS_RX_MESSAGE_SIZE - conn->rx_message_len)) return WS_CLOSE_TOO_BIG;
+    return 0;
+}
+
+// Dispatches the frame whose payload just completed. Returns false if the connection was closed.
+static bool ws_rx_end_frame(ws_connection_t *conn) {
+    ws_frame_t frame = { .final = true, .masked = true };
+    conn->rx_header_len = 0;
+    conn->rx_header_need = 2;
+
+    if (conn->rx_opcode & 0x08) {
+        frame.opcode = conn->rx_opcode;
+        frame.payload = conn->rx_control;
+        frame.payload_length = conn->rx_control_len;
+        return ws_handle_frame(conn, &frame);
+    }
+    if (!conn->rx_final) return true;   // more fragments to come
+
+    frame.opcode = conn->rx_message_opcode;
+    frame.payload = conn->rx_message;
+    frame.payload_length = conn->rx_message_len;
+    conn->rx_message_opcode = 0;
+    return ws_handle_frame(conn, &frame);
+}
+
+// Feeds received bytes to the frame parser. Returns false if the connection was closed,
+// the connection is freed then and the rest of the data must be dropped.
+static bool ws_rx_consume(ws_connection_t *conn, const uint8_t *data, size_t length) {
+    while (length) {
+        if (conn->rx_header_need) {
+            conn->rx_header[conn->rx_header_len++] = *data++;
+            length--;
+            if (conn->rx_header_len == 2) {
+                uint8_t length7 = conn->rx_header[1] & 0x7F;
+                conn->rx_header_need = 2 + ((length7 == 126) ? 2 : (length7 == 127) ? 8 : 0) +
+                                       ((conn->rx_header[1] & 0x80) ? 4 : 0);
+            }
+            if (conn->rx_header_len < conn->rx_header_need) continue;
+
+            uint16_t status = ws_rx_start_frame(conn);
+            if (status) {
+                ws_fail_connection(conn, status);
+                return false;
+            }
+            conn->rx_header_need = 0;
+            if ((conn->rx_remaining == 0) && !ws_rx_end_frame(conn)) return false;
+            continue;
+        }
+
+        size_t chunk = (conn->rx_remaining < length) ? (size_t)conn->rx_remaining : length;
+        if (conn->rx_opcode & 0x08) {
+            ws_unmask_copy(&conn->rx_control[conn->rx_control_len], data, chunk, conn->rx_mask, &conn->rx_mask_phase);
+            conn->rx_control_len += chunk;
+        } else {
+            ws_unmask_copy(&conn->rx_message[conn->rx_message_len], data, chunk, conn->rx_mask, &conn->rx_mask_phase);
+            conn->rx_message_len += chunk;
+        }
+        data += chunk;
+        length -= chunk;
+        conn->rx_remaining -= chunk;
+        if ((conn->rx_remaining == 0) && !ws_rx_end_frame(conn)) return false;
     }
-    
-    frame->payload = data + header_len;
-    return ERR_OK;
+    return true;
 }
 
-static void ws_handle_frame(ws_connection_t *conn, ws_frame_t *frame) {
+// Handles a complete control frame or reassembled message. Returns false if the connection was closed.
+static bool ws_handle_frame(ws_connection_t *conn, ws_frame_t *frame) {
     switch (frame->opcode) {
         case WS_OPCODE_CLOSE:
             websocket_close_connection(conn);
-            break;
+            return false;
             
         case WS_OPCODE_PING:
             ws_send_frame(conn, WS_OPCODE_PONG, frame->payload, frame->payload_length);
@@ -342,14 +659,17 @@ static void ws_handle_frame(ws_connection_t *conn, ws_frame_t *frame) {
             break;
             
         case WS_OPCODE_TEXT:
-            // Echo back for now (can be customized)
             printf("WebSocket: Received text: %.*s\n", (int)frame->payload_length, frame->payload);
             break;
             
+        case WS_OPCODE_BINARY:
+            printf("WebSocket: Received %lu binary bytes\n", (unsigned long)frame->payload_length);
+            break;
+            
         default:
-            // Ignore unknown opcodes
             break;
     }
+    return true;
 }
 
 static err_t ws_send_frame(ws_connection_t *conn, uint8_t opcode, const uint8_t *payload, size_t length) {
@@ -364,34 +684,36 @@ static err_t ws_send_frame(ws_connection_t *conn, uint8_t opcode, const uint8_t
         header_len = 4;
     }
     
-    uint8_t *frame = (uint8_t *)malloc(header_len + length);
-    if (frame == NULL) {
+    // Whole frames only, a partly queued frame would corrupt the stream
+    if ((header_len + length) > (WS_TX_RING_SIZE - (conn->tx_head - conn->tx_tail))) {
+        conn->tx_stats.frames_dropped++;
+        conn->tx_stats.bytes_dropped += header_len + length;
+        ws_tx_totals.frames_dropped++;
+        ws_tx_totals.bytes_dropped += header_len + length;
         return ERR_MEM;
     }
     
     // Build frame header
-    frame[0] = 0x80 | opcode; // FIN bit + opcode
+    uint8_t header[4];
+    header[0] = 0x80 | opcode; // FIN bit + opcode
     
     if (length > 125) {
-        frame[1] = 126;
-        frame[2] = (length >> 8) & 0xFF;
-        frame[3] = length & 0xFF;
+        header[1] = 126;
+        header[2] = (length >> 8) & 0xFF;
+        header[3] = length & 0xFF;
     } else {
-        frame[1] = length & 0x7F;
+        header[1] = length & 0x7F;
     }
     
-    // Copy payload
+    ws_tx_put(conn, header, header_len);
     if (payload && length > 0) {
-        memcpy(frame + header_len, payload, length);
+        ws_tx_put(conn, payload, length);
     }
+    conn->tx_stats.frames++;
+    ws_tx_totals.frames++;
     
-    err_t err = tcp_write(conn->pcb, frame, header_len + length, TCP_WRITE_FLAG_COPY);
-    if (err == ERR_OK) {
-        tcp_output(conn->pcb);
-    }
-    
-    free(frame);
-    return err;
+    ws_tx_flush(conn);
+    return ERR_OK;
 }
 
 void websocket_close_connection(ws_connection_t *conn) {
@@ -402,6 +724,12 @@ void websocket_close_connection(ws_connection_t *conn) {
     }
     
     if (conn->pcb) {
+        // the connection is freed below, lwIP must not call back into it
+        tcp_arg(conn->pcb, NULL);
+        tcp_recv(conn->pcb, NULL);
+        tcp_err(conn->pcb, NULL);
+        tcp_sent(conn->pcb, NULL);
+        tcp_poll(conn->pcb, NULL, 0);
         tcp_close(conn->pcb);
         conn->pcb = NULL;
     }
@@ -448,37 +776,85 @@ size_t websocket_get_connection_count(void) {
     return connection_count;
 }
 
+const ws_tx_stats_t *websocket_get_tx_stats(void) {
+    return &ws_tx_totals;
+}
+
+// Sends a finished message to every client, a message that did not fit is not sent at all
+static void ws_broadcast_json(json_writer_t *json, char *buffer) {
+    if (json_overflowed(json)) return;
+    buffer[json_length(json)] = '\0';
+    websocket_broadcast_text(buffer);
+}
+
 // Real-time trading event broadcasting functions
 void websocket_broadcast_trade_event(const char *event_type, const char *message) {
     char json_buffer[512];
-    snprintf(json_buffer, sizeof(json_buffer),
-        "{\"type\":\"trade_event\",\"event\":\"%s\",\"message\":\"%s\",\"timestamp\":%lu}",
-        event_type, message, sys_now());
-    websocket_broadcast_text(json_buffer);
+    json_writer_t json;
+    json_init(&json, json_buffer, sizeof(json_buffer) - 1);
+    json_object_begin(&json);
+    json_key(&json, "type");
+    json_string(&json, "trade_event");
+    json_key(&json, "event");
+    json_string(&json, event_type);
+    json_key(&json, "message");
+    json_string(&json, message);
+    json_key(&json, "timestamp");
+    json_uint(&json, sys_now());
+    json_object_end(&json);
+    ws_broadcast_json(&json, json_buffer);
 }
 
-void websocket_broadcast_protocol_data(uint8_t rx_byte, uint8_t tx_byte, const char *state) {
-    char json_buffer[256];
-    snprintf(json_buffer, sizeof(json_buffer),
-        "{\"type\":\"protocol\",\"rx\":\"0x%02X\",\"tx\":\"0x%02X\",\"state\":\"%s\",\"timestamp\":%lu}",
-        rx_byte, tx_byte, state, sys_now());
-    websocket_broadcast_text(json_buffer);
+void websocket_broadcast_protocol_data(uint8_t rx_byte, uint8_t tx_byte, trade_state_t state) {
+    ws_protocol_event_t event = { time_us_64(), rx_byte, tx_byte, (uint8_t)state };
+    // one producer side: the link interrupt and the loop it interrupts run on the same core
+    uint32_t status = save_and_disable_interrupts();
+    bool queued = spsc_queue_push(&protocol_queue, &event);
+    restore_interrupts(status);
+    if (!queued) protocol_dropped++;
 }
 
-void websocket_broadcast_pokemon_data(const char *pokemon_json) {
+uint32_t websocket_get_dropped_protocol_events(void) {
+    return protocol_dropped;
+}
+
+// {"type":type,"data":data,"timestamp":now} around a document rendered elsewhere
+static void ws_broadcast_update(const char *type, const char *data) {
     char json_buffer[1024];
-    snprintf(json_buffer, sizeof(json_buffer),
-        "{\"type\":\"pokemon_update\",\"data\":%s,\"timestamp\":%lu}",
-        pokemon_json, sys_now());
-    websocket_broadcast_text(json_buffer);
+    json_writer_t json;
+    json_init(&json, json_buffer, sizeof(json_buffer) - 1);
+    json_object_begin(&json);
+    json_key(&json, "type");
+    json_string(&json, type);
+    json_key(&json, "data");
+    json_raw_value(&json, data, strlen(data));
+    json_key(&json, "timestamp");
+    json_uint(&json, sys_now());
+    json_object_end(&json);
+    ws_broadcast_json(&json, json_buffer);
+}
+
+void websocket_broadcast_pokemon_data(const char *pokemon_json) {
+    ws_broadcast_update("pokemon_update", pokemon_json);
 }
 
 void websocket_broadcast_status_update(const char *status_json) {
-    char json_buffer[1024];
-    snprintf(json_buffer, sizeof(json_buffer),
-        "{\"type\":\"status_update\",\"data\":%s,\"timestamp\":%lu}",
-        status_json, sys_now());
-    websocket_broadcast_text(json_buffer);
+    ws_broadcast_update("status_update", status_json);
+}
+
+void websocket_broadcast_link_stats(void) {
+    static char json_buffer[2048];  // the histograms do not fit on the stack
+    json_writer_t json;
+    json_init(&json, json_buffer, sizeof(json_buffer) - 1);
+    json_object_begin(&json);
+    json_key(&json, "type");
+    json_string(&json, "link_stats");
+    json_key(&json, "timestamp");
+    json_uint(&json, sys_now());
+    json_key(&json, "data");
+    link_latency_write_json(&json);
+    json_object_end(&json);
+    ws_broadcast_json(&json, json_buffer);
 }
 
 // Utility functions